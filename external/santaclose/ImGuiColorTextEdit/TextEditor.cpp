@@ -338,13 +338,19 @@ void TextEditor::Paste(char const *aClipText)
 void TextEditor::Undo(int aSteps)
 {
   while(CanUndo() && aSteps-- > 0)
+  {
     mUndoBuffer[--mUndoIndex].Undo(this);
+    ++mEditVersion;
+  }
 }
 
 void TextEditor::Redo(int aSteps)
 {
   while(CanRedo() && aSteps-- > 0)
+  {
     mUndoBuffer[mUndoIndex++].Redo(this);
+    ++mEditVersion;
+  }
 }
 
 void TextEditor::SetText(const std::string &aText)
@@ -368,6 +374,7 @@ void TextEditor::SetText(const std::string &aText)
 
   mUndoBuffer.clear();
   mUndoIndex = 0;
+  ++mEditVersion;
 }
 
 std::string TextEditor::GetText() const
@@ -403,6 +410,7 @@ void TextEditor::SetTextLines(const std::vector<std::string> &aLines)
 
   mUndoBuffer.clear();
   mUndoIndex = 0;
+  ++mEditVersion;
 }
 
 std::vector<std::string> TextEditor::GetTextLines() const
@@ -2645,6 +2653,7 @@ void TextEditor::AddUndo(UndoRecord &aValue)
   mUndoBuffer.resize((size_t) (mUndoIndex + 1));
   mUndoBuffer.back() = aValue;
   ++mUndoIndex;
+  ++mEditVersion;
 }
 
 const TextEditor::Palette &TextEditor::GetDarkPalette()
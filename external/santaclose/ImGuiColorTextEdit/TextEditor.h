@@ -92,6 +92,8 @@ public:
   inline bool CanUndo() const { return !mReadOnly && mUndoIndex > 0; };
   inline bool CanRedo() const { return !mReadOnly && mUndoIndex < (int)mUndoBuffer.size(); };
   inline int GetUndoIndex() const { return mUndoIndex; };
+  // incremented every time the text changes (cheap way to detect edits without comparing text)
+  inline unsigned int GetEditVersion() const { return mEditVersion; };
 
   void SetText(const std::string& aText);
   std::string GetText() const;
@@ -401,6 +403,7 @@ private:
   EditorState mState;
   std::vector<UndoRecord> mUndoBuffer;
   int mUndoIndex = 0;
+  unsigned int mEditVersion = 0;
 
   int mTabSize = 2;
   float mLineSpacing = 1.0f;
@@ -22,6 +22,7 @@
 #include <emscripten/html5.h>
 
 #include <utility>
+#include <algorithm>
 
 namespace shader_toy {
 
@@ -116,35 +117,59 @@ void Application::mainLoop()
   if(!isMainLoopEnabled())
     return;
 
-  glfwPollEvents();
+  auto frameTiming = fMainLoopTimings->measure("Frame");
+
+  {
+    auto timing = fMainLoopTimings->measure("glfwPollEvents");
+    glfwPollEvents();
+  }
 
   try
   {
     // This makes sure that we control exactly when the asynchronous callbacks using
     // wgpu::CallbackMode::AllowProcessEvents are triggered (shader compilation)
-    fGPU->pollEvents();
+    {
+      auto timing = fMainLoopTimings->measure("GPU::pollEvents");
+      fGPU->pollEvents();
+    }
 
     // beforeFrame
     for(auto &r: fRenderableList)
     {
+      auto timing = r->getPhaseTimings().measure("beforeFrame");
       r->beforeFrame(); WST_INTERNAL_ASSERT(!fGPU->hasError());
     }
 
-    // GPU -> beginFrame
-    fGPU->beginFrame(); WST_INTERNAL_ASSERT(!fGPU->hasError());
-
-    // render
-    for(auto &r: fRenderableList)
+    // [On-demand rendering] nothing to render => no GPU frame at all
+    if(std::ranges::any_of(fRenderableList, [](auto const &r) { return r->needsRender(); }))
     {
-      r->render(); WST_INTERNAL_ASSERT(!fGPU->hasError());
+      // GPU -> beginFrame
+      {
+        auto timing = fMainLoopTimings->measure("GPU::beginFrame");
+        fGPU->beginFrame(); WST_INTERNAL_ASSERT(!fGPU->hasError());
+      }
+
+      // render
+      for(auto &r: fRenderableList)
+      {
+        if(r->needsRender())
+        {
+          auto timing = r->getPhaseTimings().measure("render");
+          r->render(); WST_INTERNAL_ASSERT(!fGPU->hasError());
+        }
+      }
+
+      // GPU -> endFrame
+      {
+        auto timing = fMainLoopTimings->measure("GPU::endFrame");
+        fGPU->endFrame(); WST_INTERNAL_ASSERT(!fGPU->hasError());
+      }
     }
 
-    // GPU -> endFrame
-    fGPU->endFrame(); WST_INTERNAL_ASSERT(!fGPU->hasError());
-
     // afterFrame
     for(auto &r: fRenderableList)
     {
+      auto timing = r->getPhaseTimings().measure("afterFrame");
       r->afterFrame(); WST_INTERNAL_ASSERT(!fGPU->hasError());
     }
 
@@ -42,6 +42,10 @@ public:
 
   void onDocumentVisibilityChange(bool hidden);
 
+  // CPU timings of the phases of the main loop which are not specific to a renderable (the phases of each renderable
+  // are recorded in the renderable itself)
+  std::shared_ptr<utils::PhaseTimings> getMainLoopTimings() const { return fMainLoopTimings; }
+
   static std::future<std::unique_ptr<Application>> asyncCreate(std::function<void(std::string_view)> onError);
 
 private:
@@ -52,6 +56,7 @@ private:
   std::vector<std::shared_ptr<Renderable>> fRenderableList{};
   bool fRunning{true};
   std::optional<double> fHiddenTime{};
+  std::shared_ptr<utils::PhaseTimings> fMainLoopTimings{std::make_shared<utils::PhaseTimings>("Main Loop")};
 };
 
 //------------------------------------------------------------------------
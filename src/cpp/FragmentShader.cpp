@@ -17,6 +17,10 @@
  */
 
 #include "FragmentShader.h"
+#include "utils/WGSL.h"
+#include <utility>
+#include <algorithm>
+#include <bit>
 
 namespace shader_toy {
 
@@ -26,8 +30,10 @@ namespace shader_toy {
 FragmentShader::FragmentShader(Shader const &iShader) :
   fName{iShader.fName},
   fCode{iShader.fCode},
-  fWindowSize{iShader.fWindowSize}
+  fWindowSize{iShader.fWindowSize},
+  fOverrideValues{iShader.fOverrideValues}
 {
+  updateOverrides();
   if(iShader.fEditedCode)
   {
     auto &editor = edit();
@@ -61,6 +67,7 @@ TextEditor &FragmentShader::edit()
     fTextEditor->SetLanguageDefinition(TextEditor::LanguageDefinitionId::None);
     fTextEditor->SetText(fCode);
     fTextEditor->SetShowWhitespacesEnabled(false);
+    fCodeEditVersion = fTextEditor->GetEditVersion();
   }
   return fTextEditor.value();
 }
@@ -93,7 +100,7 @@ char const *FragmentShader::getStatus() const
     if(hasCompilationError())
       return "Error";
     else
-      return "Compiling...";
+      return isLinking() ? "Linking..." : "Compiling...";
   }
 }
 
@@ -112,6 +119,7 @@ void FragmentShader::updateInputsFromClock()
 void FragmentShader::setCompilationError(State::CompiledInError const &iError)
 {
   fState = iError;
+  fCandidateRenderPipeline = nullptr;
   if(iError.fErrorLine != -1)
     edit().AddErrorMarker(iError.fErrorLine, iError.fErrorColumn, iError.fErrorMessage);
 }
@@ -137,9 +145,9 @@ void FragmentShader::tickTime(double iTimeDelta)
 //------------------------------------------------------------------------
 // FragmentShader::tickFrame
 //------------------------------------------------------------------------
-void FragmentShader::tickFrame(int iFrameCount)
+void FragmentShader::tickFrame(int iFrameCount, double iTimeDelta)
 {
-  fClock.tickFrame(iFrameCount);
+  fClock.tickFrame(iFrameCount, iTimeDelta);
   updateInputsFromClock();
 }
 
@@ -148,12 +156,175 @@ void FragmentShader::tickFrame(int iFrameCount)
 //------------------------------------------------------------------------
 void FragmentShader::updateCode(std::string iCode)
 {
+  // the shader module remains valid when only whitespace and/or comments changed
+  auto keepShaderModule = hasShaderModule() &&
+                          utils::wgsl::computeNormalizedHash(fCode) == utils::wgsl::computeNormalizedHash(iCode);
+
   fCode = std::move(iCode);
-  if(!isCompilationPending())
+  fGeneration++;
+  // any compilation request still pending or in flight is now obsolete and will be dropped
+  auto &editor = edit();
+  editor.ClearErrorMarkers();
+  if(keepShaderModule)
+    fShaderModuleGeneration = fGeneration;
+  else
+    fShaderModule = nullptr;
+  updateOverrides();
+
+  // when only whitespace and/or comments changed since the last successful compilation, the pipeline is still
+  // valid: there is nothing to compile (and no error whose line could be off)
+  auto codeHash = computePipelineCodeHash();
+  if(fCandidateRenderPipeline && codeHash == fCandidateRenderPipelineCodeHash)
+  {
+    fState = State::Compiled{};
+  }
+  else if(fRenderPipeline && codeHash == fRenderPipelineCodeHash)
+  {
+    fCandidateRenderPipeline = nullptr;
+    fState = State::Compiled{};
+  }
+  else
+  {
+    fCandidateRenderPipeline = nullptr;
+    fState = State::NotCompiled{};
+  }
+
+  fCodeEditVersion = editor.GetEditVersion();
+  fLastEditVersion = fCodeEditVersion;
+  fEdited = false;
+}
+
+//------------------------------------------------------------------------
+// FragmentShader::checkForEdits
+//------------------------------------------------------------------------
+void FragmentShader::checkForEdits(double iCurrentTime)
+{
+  auto &editor = edit();
+  auto editVersion = editor.GetEditVersion();
+  if(editVersion != fLastEditVersion)
+  {
+    fLastEditVersion = editVersion;
+    fLastEditTime = iCurrentTime;
+    fEdited = editVersion != fCodeEditVersion && editor.GetText() != fCode;
+  }
+}
+
+//------------------------------------------------------------------------
+// FragmentShader::setCandidateRenderPipeline
+//------------------------------------------------------------------------
+void FragmentShader::setCandidateRenderPipeline(wgpu::RenderPipeline iRenderPipeline)
+{
+  fCandidateRenderPipeline = std::move(iRenderPipeline);
+  fCandidateRenderPipelineCodeHash = computePipelineCodeHash();
+  fState = State::Compiled{};
+}
+
+//------------------------------------------------------------------------
+// FragmentShader::swapInCandidateRenderPipeline
+//------------------------------------------------------------------------
+void FragmentShader::swapInCandidateRenderPipeline()
+{
+  if(fCandidateRenderPipeline)
+  {
+    fRenderPipeline = std::exchange(fCandidateRenderPipeline, nullptr);
+    fRenderPipelineCodeHash = fCandidateRenderPipelineCodeHash;
+    fRenderBundles.clear();
+  }
+}
+
+//------------------------------------------------------------------------
+// FragmentShader::computePipelineCodeHash
+//------------------------------------------------------------------------
+utils::hash::hash_t FragmentShader::computePipelineCodeHash() const
+{
+  return utils::hash::combine(utils::wgsl::computeNormalizedHash(fCode), fConstantsKey);
+}
+
+//------------------------------------------------------------------------
+// FragmentShader::updateOverrides
+//------------------------------------------------------------------------
+void FragmentShader::updateOverrides()
+{
+  fOverrides = utils::wgsl::findOverrides(fCode);
+
+  // keeps the values of the overrides that still exist
+  std::erase_if(fOverrideValues, [this](auto const &iEntry) {
+    return std::ranges::none_of(fOverrides, [&iEntry](auto const &o) { return o.fName == iEntry.first; });
+  });
+
+  updateConstantsKey();
+}
+
+//------------------------------------------------------------------------
+// FragmentShader::updateConstantsKey
+//------------------------------------------------------------------------
+void FragmentShader::updateConstantsKey()
+{
+  fConstantsKey = utils::hash::kFNV1aOffsetBasis;
+  for(auto const &[name, value]: fOverrideValues)
   {
-    edit().ClearErrorMarkers();
+    fConstantsKey = utils::hash::fnv1a(name, fConstantsKey);
+    fConstantsKey = utils::hash::combine(fConstantsKey, std::bit_cast<std::uint64_t>(value));
+  }
+}
+
+//------------------------------------------------------------------------
+// FragmentShader::getOverrideValue
+//------------------------------------------------------------------------
+std::optional<double> FragmentShader::getOverrideValue(std::string const &iName) const
+{
+  if(auto iter = fOverrideValues.find(iName); iter != fOverrideValues.end())
+    return iter->second;
+  auto o = std::ranges::find(fOverrides, iName, &utils::wgsl::Override::fName);
+  if(o != fOverrides.end())
+    return o->fDefaultValue;
+  return std::nullopt;
+}
+
+//------------------------------------------------------------------------
+// FragmentShader::setOverrideValue
+//------------------------------------------------------------------------
+void FragmentShader::setOverrideValue(std::string const &iName, double iValue)
+{
+  fOverrideValues[iName] = iValue;
+  updateConstantsKey();
+  // a new pipeline is required (but not a new compilation when the shader module is available)
+  if(!isCompilationInProgress())
+    fState = State::NotCompiled{};
+}
+
+//------------------------------------------------------------------------
+// FragmentShader::resetOverrideValues
+//------------------------------------------------------------------------
+void FragmentShader::resetOverrideValues()
+{
+  if(fOverrideValues.empty())
+    return;
+  fOverrideValues.clear();
+  updateConstantsKey();
+  if(!isCompilationInProgress())
     fState = State::NotCompiled{};
+}
+
+//------------------------------------------------------------------------
+// FragmentShader::computeConstantEntries
+//------------------------------------------------------------------------
+std::vector<wgpu::ConstantEntry> FragmentShader::computeConstantEntries() const
+{
+  std::vector<wgpu::ConstantEntry> res{};
+  for(auto const &o: fOverrides)
+  {
+    // overrides without initializer must always be provided
+    auto value = getOverrideValue(o.fName);
+    if(fOverrideValues.contains(o.fName) || !o.fInitializer)
+    {
+      res.emplace_back(wgpu::ConstantEntry{
+        .key = {o.fConstantKey.data(), o.fConstantKey.size()},
+        .value = value.value_or(0.0)
+      });
+    }
   }
+  return res;
 }
 
 //------------------------------------------------------------------------
@@ -163,6 +334,11 @@ std::unique_ptr<FragmentShader> FragmentShader::clone() const
 {
   auto res = std::make_unique<FragmentShader>(*this);
   res->fState = State::NotCompiled{};
+  res->fRenderPipeline = nullptr;
+  res->fCandidateRenderPipeline = nullptr;
+  res->fShaderModule = nullptr;
+  res->fRenderBundles.clear();
+  res->fRenderBundlesBindGroup = nullptr;
   return res;
 }
 
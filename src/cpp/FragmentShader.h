@@ -23,10 +23,17 @@
 #include <string>
 #include <variant>
 #include <optional>
+#include <cstdint>
+#include <map>
+#include <vector>
 #include <webgpu/webgpu_cpp.h>
 #include "TextEditor.h"
 #include "State.h"
+#include "gpu/Renderable.h"
+#include "ShaderToyWGSL.h"
 #include "utils/Clock.h"
+#include "utils/Hash.h"
+#include "utils/WGSL.h"
 
 namespace pongasoft::gpu {
 using vec2f = ImVec2;
@@ -42,24 +49,14 @@ namespace shader_toy {
 class FragmentShader
 {
 public:
-  static constexpr char kHeader[] = R"(// Begin ShaderToy Header
-struct ShaderToyInputs {
-  size:  vec4f,
-  mouse: vec4f,
-  time:  f32,
-  frame: i32,
-};
-
-@group(0) @binding(0) var<uniform> inputs: ShaderToyInputs;
-// End ShaderToy Header
-
-)";
+  static constexpr auto &kHeader = kShaderToyHeader;
 
   static constexpr char kHeaderTemplate[] = R"(struct ShaderToyInputs {
   size:         vec4f, [%d, %d, %.2f, %.2f]
   mouse:        vec4f, [%d, %d, %d, %d]
   time:         f32,   [%.2f]
   frame:        i32,   [%d]
+  offset:       vec2f, [%d, %d]
 };)";
 
   struct ShaderToyInputs
@@ -68,17 +65,23 @@ struct ShaderToyInputs {
     gpu::vec4f mouse{};
     gpu::f32 time{};
     gpu::i32 frame{};
+    // position of the rendered area in the full image (only a tile of the full image is rendered in a hi-res
+    // screenshot)
+    gpu::vec2f offset{};
   };
 
   struct State {
     enum class NotCompiled {};
     enum class CompilationPending{};
     enum class Compiling{};
+    enum class Linking{};
     struct CompiledInError { std::string fErrorMessage; int fErrorLine{-1}; int fErrorColumn{}; };
-    struct Compiled { wgpu::RenderPipeline fRenderPipeline; };
+    enum class Compiled{};
   };
 
-  using state_t = std::variant<State::NotCompiled, State::CompilationPending, State::Compiling, State::CompiledInError, State::Compiled>;
+  using generation_t = std::uint64_t;
+
+  using state_t = std::variant<State::NotCompiled, State::CompilationPending, State::Compiling, State::Linking, State::CompiledInError, State::Compiled>;
 
 public:
   explicit FragmentShader(Shader const &iShader);
@@ -88,6 +91,8 @@ public:
   std::string const &getName() const { return fName; }
   void setName(std::string iName) { fName = std::move(iName); }
   std::string const &getCode() const { return fCode; }
+  // incremented every time the code changes (used to detect obsolete compilation requests)
+  constexpr generation_t getGeneration() const { return fGeneration; }
   std::optional<std::string> getEditedCode() const;
   gpu::Renderable::Size const &getWindowSize() const { return fWindowSize; }
   void setWindowSize(gpu::Renderable::Size const &iSize) { fWindowSize = iSize; }
@@ -97,6 +102,11 @@ public:
   int getCompilationErrorLine() const { return std::get<FragmentShader::State::CompiledInError>(fState).fErrorLine; }
   int getCompilationErrorColumn() const { return std::get<FragmentShader::State::CompiledInError>(fState).fErrorColumn; }
   constexpr bool isCompiled() const { return std::holds_alternative<FragmentShader::State::Compiled>(fState); }
+  constexpr bool isCompilationInProgress() const { return isCompilationPending() || isCompiling() || isLinking(); }
+  // the pipeline currently rendering (kept while a new version compiles or fails to compile)
+  inline bool hasRenderPipeline() const { return fRenderPipeline != nullptr; }
+  // a newly compiled pipeline waiting to replace the current one at the next frame
+  inline bool hasCandidateRenderPipeline() const { return fCandidateRenderPipeline != nullptr; }
 
   void toggleRunning();
   constexpr bool isRunning() const { return fClock.isRunning(); }
@@ -110,7 +120,7 @@ public:
 
   char const* getStatus() const;
 
-  void nextFrame(int iFrameCount = 1) { tickFrame(iFrameCount); }
+  void nextFrame(int iFrameCount = 1, double iTimeDelta = 1.0/60.0) { tickFrame(iFrameCount, iTimeDelta); }
 
   void previousFrame(int iFrameCount = 1) { tickFrame(-iFrameCount); }
 
@@ -118,6 +128,20 @@ public:
 
   void updateCode(std::string iCode);
 
+  // detects changes in the editor using its edit version (the text is compared only when the version changes)
+  void checkForEdits(double iCurrentTime);
+  constexpr bool isEdited() const { return fEdited; }
+  constexpr double getLastEditTime() const { return fLastEditTime; }
+
+  // override declarations (pipeline constants) and their current values
+  std::vector<utils::wgsl::Override> const &getOverrides() const { return fOverrides; }
+  std::map<std::string, double> const &getOverrideValues() const { return fOverrideValues; }
+  std::optional<double> getOverrideValue(std::string const &iName) const;
+  void setOverrideValue(std::string const &iName, double iValue);
+  void resetOverrideValues();
+  constexpr utils::hash::hash_t getConstantsKey() const { return fConstantsKey; }
+  std::vector<wgpu::ConstantEntry> computeConstantEntries() const;
+
   std::unique_ptr<FragmentShader> clone() const;
 
   friend class FragmentShaderWindow;
@@ -125,23 +149,51 @@ public:
 private:
   constexpr bool isCompilationPending() const { return std::holds_alternative<FragmentShader::State::CompilationPending>(fState); }
   constexpr bool isCompiling() const { return std::holds_alternative<FragmentShader::State::Compiling>(fState); }
+  constexpr bool isLinking() const { return std::holds_alternative<FragmentShader::State::Linking>(fState); }
   constexpr bool isNotCompiled() const { return std::holds_alternative<FragmentShader::State::NotCompiled>(fState); }
-  wgpu::RenderPipeline getRenderPipeline() const { return std::get<FragmentShader::State::Compiled>(fState).fRenderPipeline; }
+  wgpu::RenderPipeline getRenderPipeline() const { return fRenderPipeline; }
+  void setCandidateRenderPipeline(wgpu::RenderPipeline iRenderPipeline);
+  void swapInCandidateRenderPipeline();
   void tickTime(double iTimeDelta);
-  void tickFrame(int iFrameCount);
+  void tickFrame(int iFrameCount, double iTimeDelta = 1.0/60.0);
   void updateInputsFromClock();
   void setCompilationError(State::CompiledInError const &iError);
+  void updateOverrides();
+  void updateConstantsKey();
+  utils::hash::hash_t computePipelineCodeHash() const;
+  inline bool hasShaderModule() const { return fShaderModule != nullptr && fShaderModuleGeneration == fGeneration; }
 
 private:
   std::string fName;
   std::string fCode;
+  generation_t fGeneration{};
   gpu::Renderable::Size fWindowSize;
 
   ShaderToyInputs fInputs{};
 
   state_t fState{State::NotCompiled{}};
+  wgpu::RenderPipeline fRenderPipeline{};
+  wgpu::RenderPipeline fCandidateRenderPipeline{};
+  // the compiled code (kept to create new pipelines when only the constants change)
+  wgpu::ShaderModule fShaderModule{};
+  generation_t fShaderModuleGeneration{};
+  // normalized hash (ignoring whitespace and comments) of the code (and constants) each pipeline was created from
+  utils::hash::hash_t fRenderPipelineCodeHash{};
+  utils::hash::hash_t fCandidateRenderPipelineCodeHash{};
+  // commands recorded once for the current pipeline (one per inputs slot) and replayed at every frame (obsolete as
+  // soon as the pipeline or the bind group changes)
+  std::vector<wgpu::RenderBundle> fRenderBundles{};
+  WGPUBindGroup fRenderBundlesBindGroup{};
 
   std::optional<TextEditor> fTextEditor{};
+  unsigned int fCodeEditVersion{};
+  unsigned int fLastEditVersion{};
+  double fLastEditTime{};
+  bool fEdited{};
+
+  std::vector<utils::wgsl::Override> fOverrides{};
+  std::map<std::string, double> fOverrideValues{};
+  utils::hash::hash_t fConstantsKey{};
 
   utils::Clock fClock{};
   bool fEnabled{true};
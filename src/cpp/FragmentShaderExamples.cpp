@@ -24,14 +24,14 @@ namespace shader_toy {
 
 std::vector<Shader> kBuiltInFragmentShaderExamples{
   // Hello World
-  {"Hello World", R"(@fragment
+  {.fName = "Hello World", .fCode = R"(@fragment
 fn fragmentMain(@builtin(position) pos: vec4f) -> @location(0) vec4f {
     return vec4f(pos.xy / inputs.size.xy, 0.5, 1);
 }
 )"},
 
   // Tutorial
-  {"Tutorial", R"(/*
+  {.fName = "Tutorial", .fCode = R"(/*
 - You must define a function called fragmentMain which must return a color (vec4f)
 
 - This function is called for each pixel:
@@ -21,6 +21,10 @@
 #include "Errors.h"
 #include <GLFW/glfw3.h>
 #include <map>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <numeric>
 
 #include <utility>
 
@@ -30,27 +34,33 @@
 
 namespace shader_toy {
 
-constexpr char kVertexShader[] = R"(
+constexpr char kBlitShader[] = R"(
+@group(0) @binding(0) var blitSampler: sampler;
+@group(0) @binding(1) var blitTexture: texture_2d<f32>;
+
+struct VertexOutput {
+  @builtin(position) position: vec4f,
+  @location(0) uv: vec2f,
+};
+
+// one triangle covering the whole surface
 @vertex
-fn vertexMain(@builtin(vertex_index) i : u32) -> @builtin(position) vec4f {
-    const pos = array(vec2f(-1, 1), vec2f(-1, -1), vec2f(1, -1), vec2f(-1, 1), vec2f(1, -1), vec2f(1, 1));
-    return vec4f(pos[i], 0, 1);
+fn vertexMain(@builtin(vertex_index) i : u32) -> VertexOutput {
+  let uv = vec2f(f32((i << 1u) & 2u), f32(i & 2u));
+  var output: VertexOutput;
+  output.position = vec4f(uv * vec2f(2, -2) + vec2f(-1, 1), 0, 1);
+  output.uv = uv;
+  return output;
+}
+
+@fragment
+fn fragmentMain(input: VertexOutput) -> @location(0) vec4f {
+  return textureSample(blitTexture, blitSampler, input.uv);
 }
 )";
 
 namespace callbacks {
 
-
-struct FragmentShaderCompilationRequest
-{
-  std::shared_ptr<FragmentShaderWindow> fFragmentShaderWindow;
-  std::shared_ptr<FragmentShader> fFragmentShader;
-  wgpu::ShaderModule fShaderModule{};
-};
-
-// Only one at a time...
-static std::unique_ptr<FragmentShaderCompilationRequest> kFragmentShaderCompilationRequest{};
-
 //------------------------------------------------------------------------
 // callbacks::onFrameBufferSizeChange
 //------------------------------------------------------------------------
@@ -71,22 +81,6 @@ void onContentScaleChange(GLFWwindow *window, float xScale, float yScale)
 
 }
 
-//------------------------------------------------------------------------
-// callbacks::onShaderCompilationResult
-// implementation note: API is using webgpu.h style, not wegpu_cpp.h
-//------------------------------------------------------------------------
-void onShaderCompilationResult(WGPUCompilationInfoRequestStatus iStatus,
-                               WGPUCompilationInfo const *iCompilationInfo,
-                               void *iUserData)
-{
-  WST_INTERNAL_ASSERT(kFragmentShaderCompilationRequest && iUserData == kFragmentShaderCompilationRequest.get());
-  auto request = std::move(kFragmentShaderCompilationRequest);
-  request->fFragmentShaderWindow->onShaderCompilationResult(request->fFragmentShader,
-                                                            request->fShaderModule,
-                                                            static_cast<wgpu::CompilationInfoRequestStatus>(iStatus),
-                                                            iCompilationInfo);
-}
-
 }
 
 //------------------------------------------------------------------------
@@ -96,19 +90,18 @@ FragmentShaderWindow::FragmentShaderWindow(std::shared_ptr<gpu::GPU> iGPU, Windo
   Window(std::move(iGPU), iWindowArgs)
 {
   fFrameBufferSize = getFrameBufferSize();
+  fRenderSize = fFrameBufferSize;
   glfwSetCursorPosCallback(fWindow, callbacks::onCursorPosChange);
   glfwGetWindowContentScale(fWindow, &fContentScale.x, &fContentScale.y);
   glfwSetWindowContentScaleCallback(fWindow, callbacks::onContentScaleChange);
+  getPhaseTimings().setName("Shader Window");
   initGPU();
 }
 
 //------------------------------------------------------------------------
 // FragmentShaderWindow::~FragmentShaderWindow
 //------------------------------------------------------------------------
-FragmentShaderWindow::~FragmentShaderWindow()
-{
-  callbacks::kFragmentShaderCompilationRequest = nullptr;
-}
+FragmentShaderWindow::~FragmentShaderWindow() = default;
 
 #define MEMALIGN(_SIZE,_ALIGN)        (((_SIZE) + ((_ALIGN) - 1)) & ~((_ALIGN) - 1))    // Memory align (copied from IM_ALIGN() macro).
 
@@ -125,18 +118,34 @@ void FragmentShaderWindow::initGPU()
   group0BindGroupLayoutEntries[0].binding = 0;
   group0BindGroupLayoutEntries[0].visibility = wgpu::ShaderStage::Fragment;
   group0BindGroupLayoutEntries[0].buffer.type = wgpu::BufferBindingType::Uniform;
+  group0BindGroupLayoutEntries[0].buffer.hasDynamicOffset = true;
 
   wgpu::BindGroupLayoutDescriptor group0BindGroupLayoutDescriptor = {
     .entryCount = 1,
     .entries = group0BindGroupLayoutEntries
   };
 
-  fGroup0BindGroupLayout = device.CreateBindGroupLayout(&group0BindGroupLayoutDescriptor);
+  auto &objectCache = fGPU->getObjectCache();
+  fGroup0BindGroupLayout = objectCache.getBindGroupLayout(group0BindGroupLayoutDescriptor);
+
+  // the layout is the same for every shader
+  wgpu::PipelineLayoutDescriptor pipeLineLayoutDescriptor = {
+    .label = "Fragment Shader Pipeline Layout",
+    .bindGroupLayoutCount = 1,
+    .bindGroupLayouts = &fGroup0BindGroupLayout
+  };
+  fRenderPipelineLayout = objectCache.getPipelineLayout(pipeLineLayoutDescriptor);
+
+  // each slot of the ring must be aligned on the device's minimum offset alignment (for dynamic offsets)
+  wgpu::Limits limits{};
+  device.GetLimits(&limits);
+  fShaderToyInputsSlotSize = MEMALIGN(MEMALIGN(static_cast<std::uint32_t>(sizeof(FragmentShader::ShaderToyInputs)), 16),
+                                      limits.minUniformBufferOffsetAlignment);
 
   wgpu::BufferDescriptor desc{
     .label = "FragmentShaderWindow | ShaderToyInputs Buffer",
     .usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform,
-    .size = MEMALIGN(sizeof(FragmentShader::ShaderToyInputs), 16)
+    .size = static_cast<std::uint64_t>(fShaderToyInputsSlotSize) * kInputsRingSize
   };
   fShaderToyInputsBuffer = device.CreateBuffer(&desc);
 
@@ -154,13 +163,78 @@ void FragmentShaderWindow::initGPU()
   fGroup0BindGroup = device.CreateBindGroup(&group0BindGroupDescriptor);
 
   // vertex shader
-  wgpu::ShaderSourceWGSL vertexShaderSource{};
-  vertexShaderSource.code = kVertexShader;
-  wgpu::ShaderModuleDescriptor vertexShaderModuleDescriptor{
-    .nextInChain = &vertexShaderSource,
-    .label = "FragmentShaderWindow | Vertex Shader"
+  fVertexShaderModule = objectCache.getShaderModule(kShaderToyVertexShader, "FragmentShaderWindow | Vertex Shader");
+
+  // the tiles are read back as RGBA (the canvas API expects RGBA) and use the same color space as the surface
+  fHiResScreenshot = std::make_shared<HiResScreenshot>(fGPU, HiResScreenshot::Args{
+    .fBindGroupLayout = fGroup0BindGroupLayout,
+    .fPipelineLayout = fRenderPipelineLayout,
+    .fVertexShaderModule = fVertexShaderModule,
+    .fFormat = fGamma == 1.0 ? wgpu::TextureFormat::RGBA8Unorm : wgpu::TextureFormat::RGBA8UnormSrgb
+  });
+
+  // the frames are rendered with the (render bundles of the) shader so they use the same format as the surface
+  fFrameCapture = std::make_shared<FrameCapture>(fGPU, fPreferredFormat);
+
+  // measures the pass rendering the shader (the first pass of each frame)
+  fPassTimer = std::make_shared<gpu::PassTimer>(device);
+
+  initBlitGPU();
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::initBlitGPU
+//------------------------------------------------------------------------
+void FragmentShaderWindow::initBlitGPU()
+{
+  auto device = fGPU->getDevice();
+  auto &objectCache = fGPU->getObjectCache();
+
+  wgpu::BindGroupLayoutEntry blitBindGroupLayoutEntries[2] = {};
+  // @group(0) @binding(0) var blitSampler: sampler;
+  blitBindGroupLayoutEntries[0].binding = 0;
+  blitBindGroupLayoutEntries[0].visibility = wgpu::ShaderStage::Fragment;
+  blitBindGroupLayoutEntries[0].sampler.type = wgpu::SamplerBindingType::Filtering;
+  // @group(0) @binding(1) var blitTexture: texture_2d<f32>;
+  blitBindGroupLayoutEntries[1].binding = 1;
+  blitBindGroupLayoutEntries[1].visibility = wgpu::ShaderStage::Fragment;
+  blitBindGroupLayoutEntries[1].texture.sampleType = wgpu::TextureSampleType::Float;
+  blitBindGroupLayoutEntries[1].texture.viewDimension = wgpu::TextureViewDimension::e2D;
+
+  fBlitBindGroupLayout = objectCache.getBindGroupLayout({
+    .entryCount = 2,
+    .entries = blitBindGroupLayoutEntries
+  });
+
+  fBlitSampler = objectCache.getSampler({
+    .magFilter = wgpu::FilterMode::Linear,
+    .minFilter = wgpu::FilterMode::Linear
+  });
+
+  auto blitShaderModule = objectCache.getShaderModule(kBlitShader, "FragmentShaderWindow | Blit Shader");
+
+  wgpu::ColorTargetState colorTargetState{.format = fPreferredFormat};
+
+  wgpu::FragmentState fragmentState{
+    .module = blitShaderModule,
+    .entryPoint = "fragmentMain",
+    .targetCount = 1,
+    .targets = &colorTargetState
   };
-  fVertexShaderModule = device.CreateShaderModule(&vertexShaderModuleDescriptor);
+
+  wgpu::RenderPipelineDescriptor renderPipelineDescriptor{
+    .label = "FragmentShaderWindow | Blit Pipeline",
+    .layout = objectCache.getPipelineLayout({.bindGroupLayoutCount = 1, .bindGroupLayouts = &fBlitBindGroupLayout}),
+    .vertex{
+      .module = blitShaderModule,
+      .entryPoint = "vertexMain"
+    },
+    .primitive = wgpu::PrimitiveState{},
+    .multisample = wgpu::MultisampleState{},
+    .fragment = &fragmentState,
+  };
+
+  fBlitRenderPipeline = device.CreateRenderPipeline(&renderPipelineDescriptor);
 }
 
 
@@ -170,18 +244,55 @@ void FragmentShaderWindow::initGPU()
 //------------------------------------------------------------------------
 void FragmentShaderWindow::compile(std::shared_ptr<FragmentShader> iFragmentShader)
 {
-  if(callbacks::kFragmentShaderCompilationRequest)
+  if(maybeUseCachedRenderPipeline(iFragmentShader))
+    return;
+
+  auto generation = iFragmentShader->getGeneration();
+  CompilationRequest request{
+    .fFragmentShader = std::move(iFragmentShader),
+    .fGeneration = generation
+  };
+
+  // already waiting for a compilation slot
+  if(request.fFragmentShader->isCompilationPending())
+    return;
+
+  // [Trace] from the request to the result (including the time spent waiting for a compilation slot)
+  if(!request.fFragmentShader->hasShaderModule())
+    request.fTraceId = utils::trace::Tracer::instance().beginAsync("Shader Compilation",
+                                                                   "gpu",
+                                                                   request.fFragmentShader->getName());
+
+  if(fInFlightCompilationCount >= fMaxInFlightCompilations)
   {
-    // there is already a shader being compiled... enqueuing until it completes
-    if(!iFragmentShader->isCompilationPending())
-    {
-      iFragmentShader->fState = FragmentShader::State::CompilationPending{};
-      fPendingCompilationRequests.emplace_back(std::move(iFragmentShader));
-    }
+    // all compilation slots are in use... enqueuing until one frees up
+    request.fFragmentShader->fState = FragmentShader::State::CompilationPending{};
+    fPendingCompilationRequests.emplace_back(std::move(request));
+    return;
+  }
+
+  startCompilation(std::move(request));
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::startCompilation
+//------------------------------------------------------------------------
+void FragmentShaderWindow::startCompilation(CompilationRequest iRequest)
+{
+  auto const &fragmentShader = iRequest.fFragmentShader;
+
+  // the slot is held until the pipeline is created (or the compilation fails)
+  fInFlightCompilationCount++;
+
+  // only the constants changed: the shader module is still valid and only a new pipeline is needed
+  if(fragmentShader->hasShaderModule())
+  {
+    auto shaderModule = fragmentShader->fShaderModule;
+    createRenderPipeline(iRequest, std::move(shaderModule));
     return;
   }
 
-  auto shader = std::string(FragmentShader::kHeader) + iFragmentShader->getCode();
+  auto shader = std::string(FragmentShader::kHeader) + fragmentShader->getCode();
 
   // fragment shader
   wgpu::ShaderSourceWGSL fragmentShaderSource{};
@@ -191,26 +302,92 @@ void FragmentShaderWindow::compile(std::shared_ptr<FragmentShader> iFragmentShad
     .label = "FragmentShaderWindow | Fragment Shader"
   };
 
-  iFragmentShader->fState = FragmentShader::State::Compiling{};
+  fragmentShader->fState = FragmentShader::State::Compiling{};
 
   auto shaderModule = fGPU->getDevice().CreateShaderModule(&fragmentShaderModuleDescriptor);
 
-  callbacks::kFragmentShaderCompilationRequest =
-    std::make_unique<callbacks::FragmentShaderCompilationRequest>(callbacks::FragmentShaderCompilationRequest{
-      .fFragmentShaderWindow = shared_from_this(),
-      .fFragmentShader = std::move(iFragmentShader),
-      .fShaderModule = shaderModule
-    });
-
+  // each request carries its own state (the window is held weakly so that a pending callback does not keep it alive)
   shaderModule.GetCompilationInfo(wgpu::CallbackMode::AllowProcessEvents,
-                                  [](wgpu::CompilationInfoRequestStatus iStatus,
-                                     const wgpu::CompilationInfo* iCompilationInfo) {
-                                    callbacks::onShaderCompilationResult(static_cast<WGPUCompilationInfoRequestStatus>(iStatus),
-                                                                         reinterpret_cast<const WGPUCompilationInfo*>(iCompilationInfo),
-                                                                         callbacks::kFragmentShaderCompilationRequest.get());
+                                  [window = weak_from_this(),
+                                   request = std::move(iRequest),
+                                   shaderModule](wgpu::CompilationInfoRequestStatus iStatus,
+                                                 wgpu::CompilationInfo const *iCompilationInfo) {
+                                    if(auto w = window.lock())
+                                    {
+                                      w->onShaderCompilationResult(request,
+                                                                   shaderModule,
+                                                                   iStatus,
+                                                                   reinterpret_cast<WGPUCompilationInfo const *>(iCompilationInfo));
+                                    }
                                   });
 }
 
+//------------------------------------------------------------------------
+// FragmentShaderWindow::scheduleNextCompilations
+//------------------------------------------------------------------------
+void FragmentShaderWindow::scheduleNextCompilations()
+{
+  // requests superseded by a more recent edit never reach the GPU
+  std::erase_if(fPendingCompilationRequests, [](auto const &r) {
+    if(!r.isSuperseded())
+      return false;
+    utils::trace::Tracer::instance().endAsync(r.fTraceId, "Shader Compilation", "gpu", "superseded");
+    return true;
+  });
+
+  while(!fPendingCompilationRequests.empty() && fInFlightCompilationCount < fMaxInFlightCompilations)
+  {
+    // the shader currently visible always gets priority
+    auto iter = std::find_if(fPendingCompilationRequests.begin(),
+                             fPendingCompilationRequests.end(),
+                             [this](auto const &r) { return r.fFragmentShader == fCurrentFragmentShader; });
+    if(iter == fPendingCompilationRequests.end())
+      iter = fPendingCompilationRequests.begin();
+    auto request = std::move(*iter);
+    fPendingCompilationRequests.erase(iter);
+    request.fFragmentShader->fState = FragmentShader::State::NotCompiled{};
+    if(!maybeUseCachedRenderPipeline(request.fFragmentShader))
+      startCompilation(std::move(request));
+  }
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::computeRenderPipelineKey
+//------------------------------------------------------------------------
+utils::hash::hash_t FragmentShaderWindow::computeRenderPipelineKey(FragmentShader const &iFragmentShader) const
+{
+  auto key = utils::hash::fnv1a(FragmentShader::kHeader);
+  key = utils::hash::fnv1a(iFragmentShader.getCode(), key);
+  key = utils::hash::combine(key, iFragmentShader.getConstantsKey());
+  return utils::hash::combine(key, static_cast<std::uint64_t>(fPreferredFormat));
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::maybeUseCachedRenderPipeline
+//------------------------------------------------------------------------
+bool FragmentShaderWindow::maybeUseCachedRenderPipeline(std::shared_ptr<FragmentShader> const &iFragmentShader)
+{
+  auto cached = fRenderPipelineCache.find(computeRenderPipelineKey(*iFragmentShader));
+  if(!cached)
+    return false;
+
+  // same code has already been compiled (duplicate, undo, revert to a previous edit, previous constants...)
+  iFragmentShader->edit().ClearErrorMarkers();
+  iFragmentShader->fShaderModule = cached->fShaderModule;
+  iFragmentShader->fShaderModuleGeneration = iFragmentShader->getGeneration();
+  iFragmentShader->setCandidateRenderPipeline(cached->fRenderPipeline);
+  return true;
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::setMaxInFlightCompilations
+//------------------------------------------------------------------------
+void FragmentShaderWindow::setMaxInFlightCompilations(int iMaxInFlightCompilations)
+{
+  fMaxInFlightCompilations = std::max(1, iMaxInFlightCompilations);
+  scheduleNextCompilations();
+}
+
 namespace impl {
 
 //------------------------------------------------------------------------
@@ -255,100 +432,158 @@ std::optional<FragmentShader::State::CompiledInError> computeErrorState(wgpu::Co
 //------------------------------------------------------------------------
 // FragmentShaderWindow::onShaderCompilationResult
 //------------------------------------------------------------------------
-void FragmentShaderWindow::onShaderCompilationResult(std::shared_ptr<FragmentShader> const &iFragmentShader,
+void FragmentShaderWindow::onShaderCompilationResult(CompilationRequest const &iRequest,
                                                      wgpu::ShaderModule iShaderModule,
                                                      wgpu::CompilationInfoRequestStatus iStatus,
                                                      WGPUCompilationInfo const *iCompilationInfo)
 {
   //  wgpu_shader_toy_print_stack_trace("FragmentShaderWindow::onShaderCompilationResult");
 
-  // it is possible (rare) that compile() was called again before this async callback is called
-  if(iFragmentShader->isCompiling())
+  utils::trace::Tracer::instance().endAsync(iRequest.fTraceId,
+                                            "Shader Compilation",
+                                            "gpu",
+                                            iRequest.fFragmentShader->getName());
+
+  // the code may have changed while this request was in flight: the result is obsolete and simply dropped
+  if(!iRequest.isSuperseded() && iRequest.fFragmentShader->isCompiling())
   {
     if(auto errorState = impl::computeErrorState(iStatus, iCompilationInfo))
     {
-      iFragmentShader->setCompilationError(errorState.value());
+      iRequest.fFragmentShader->setCompilationError(errorState.value());
       fGPU->consumeError();
+    }
+    else
+    {
+      iRequest.fFragmentShader->fShaderModule = iShaderModule;
+      iRequest.fFragmentShader->fShaderModuleGeneration = iRequest.fGeneration;
+      // the slot is released once the pipeline is created
+      createRenderPipeline(iRequest, std::move(iShaderModule));
       return;
     }
+  }
 
-    auto device = fGPU->getDevice();
-
-    wgpu::BlendState blendState {
-      .color {
-        .operation = wgpu::BlendOperation::Add,
-        .srcFactor = wgpu::BlendFactor::SrcAlpha,
-        .dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha,
-      },
-      // note: copied from imgui (!= from learn webgpu)
-      .alpha {
-        .operation = wgpu::BlendOperation::Add,
-        .srcFactor = wgpu::BlendFactor::SrcAlpha,
-        .dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha,
-      }
-    };
+  fInFlightCompilationCount--;
 
-    wgpu::ColorTargetState colorTargetState{.format = fPreferredFormat, .blend = &blendState};
+  // scheduling the next ones if there are pending ones
+  scheduleNextCompilations();
+}
 
-    wgpu::FragmentState fragmentState{
-      .module = std::move(iShaderModule),
-      .entryPoint = "fragmentMain",
-      .constantCount = 0,
-      .constants = nullptr,
-      .targetCount = 1,
-      .targets = &colorTargetState
-    };
+//------------------------------------------------------------------------
+// FragmentShaderWindow::createRenderPipeline
+//------------------------------------------------------------------------
+void FragmentShaderWindow::createRenderPipeline(CompilationRequest const &iRequest, wgpu::ShaderModule iShaderModule)
+{
+  auto device = fGPU->getDevice();
 
-    wgpu::PipelineLayoutDescriptor pipeLineLayoutDescriptor = {
-      .label = "Fragment Shader Pipeline Layout",
-      .bindGroupLayoutCount = 1,
-      .bindGroupLayouts = &fGroup0BindGroupLayout
-    };
+  // the pipeline is created with the constants (override values) as they are now
+  auto request = iRequest;
+  request.fConstantsKey = request.fFragmentShader->getConstantsKey();
+  request.fRenderPipelineKey = computeRenderPipelineKey(*request.fFragmentShader);
+  request.fTraceId = utils::trace::Tracer::instance().beginAsync("Pipeline Creation",
+                                                                 "gpu",
+                                                                 request.fFragmentShader->getName());
+  auto constants = request.fFragmentShader->computeConstantEntries();
+
+  wgpu::BlendState blendState {
+    .color {
+      .operation = wgpu::BlendOperation::Add,
+      .srcFactor = wgpu::BlendFactor::SrcAlpha,
+      .dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha,
+    },
+    // note: copied from imgui (!= from learn webgpu)
+    .alpha {
+      .operation = wgpu::BlendOperation::Add,
+      .srcFactor = wgpu::BlendFactor::SrcAlpha,
+      .dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha,
+    }
+  };
 
-    wgpu::RenderPipelineDescriptor renderPipelineDescriptor{
-      .label = "Fragment Shader Pipeline",
-      .layout = device.CreatePipelineLayout(&pipeLineLayoutDescriptor),
-      .vertex{
-        .module = fVertexShaderModule,
-        .entryPoint = "vertexMain"
-      },
-      .primitive = wgpu::PrimitiveState{},
-      .multisample = wgpu::MultisampleState{},
-      .fragment = &fragmentState,
-    };
+  wgpu::ColorTargetState colorTargetState{.format = fPreferredFormat, .blend = &blendState};
 
-    // Once the code does not have any error, there could still be a problem
-    // if the main entry point (fragmentMain) is missing because the user renamed it
-    // or simply cleared the file
-    device.PushErrorScope(wgpu::ErrorFilter::Validation);
-    auto pipeline = device.CreateRenderPipeline(&renderPipelineDescriptor);
-    WST_INTERNAL_ASSERT(pipeline != nullptr, "Cannot create render pipeline");
-    device.PopErrorScope(wgpu::CallbackMode::AllowProcessEvents,
-                         [iFragmentShader, pipeline, this](wgpu::PopErrorScopeStatus iPopStatus,
-                                                           wgpu::ErrorType iErrorType,
-                                                           char const *iErrorMessage) {
-                           if(iPopStatus == wgpu::PopErrorScopeStatus::Success && iErrorType != wgpu::ErrorType::NoError)
-                           {
-                             iFragmentShader->setCompilationError({
-                               .fErrorMessage = fmt::printf("Validation error: Make sure there is a function called fragmentMain\n%s", iErrorMessage)
-                             });
-                           }
-                           else
-                           {
-                             iFragmentShader->fState = FragmentShader::State::Compiled{.fRenderPipeline = pipeline};
-                             initFragmentShader(iFragmentShader);
-                           }
-                         });
-  }
+  wgpu::FragmentState fragmentState{
+    .module = std::move(iShaderModule),
+    .entryPoint = "fragmentMain",
+    .constantCount = constants.size(),
+    .constants = constants.data(),
+    .targetCount = 1,
+    .targets = &colorTargetState
+  };
+
+  wgpu::RenderPipelineDescriptor renderPipelineDescriptor{
+    .label = "Fragment Shader Pipeline",
+    .layout = fRenderPipelineLayout,
+    .vertex{
+      .module = fVertexShaderModule,
+      .entryPoint = "vertexMain"
+    },
+    .primitive = wgpu::PrimitiveState{},
+    .multisample = wgpu::MultisampleState{},
+    .fragment = &fragmentState,
+  };
+
+  request.fFragmentShader->fState = FragmentShader::State::Linking{};
+
+  // Building the pipeline can take a long time for heavy shaders, so it is done asynchronously in order to keep
+  // rendering the UI while it happens.
+  // Once the code does not have any error, there could still be a problem
+  // if the main entry point (fragmentMain) is missing because the user renamed it
+  // or simply cleared the file
+  device.CreateRenderPipelineAsync(&renderPipelineDescriptor,
+                                   wgpu::CallbackMode::AllowProcessEvents,
+                                   [window = weak_from_this(),
+                                    request = std::move(request)](wgpu::CreatePipelineAsyncStatus iStatus,
+                                                        wgpu::RenderPipeline iPipeline,
+                                                        auto const &iMessage) {
+                                     if(auto w = window.lock())
+                                     {
+                                       w->onRenderPipelineCreated(request,
+                                                                  iStatus,
+                                                                  std::move(iPipeline),
+                                                                  std::string(iMessage));
+                                     }
+                                   });
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::onRenderPipelineCreated
+//------------------------------------------------------------------------
+void FragmentShaderWindow::onRenderPipelineCreated(CompilationRequest const &iRequest,
+                                                   wgpu::CreatePipelineAsyncStatus iStatus,
+                                                   wgpu::RenderPipeline iPipeline,
+                                                   std::string const &iErrorMessage)
+{
+  auto const &fragmentShader = iRequest.fFragmentShader;
+
+  utils::trace::Tracer::instance().endAsync(iRequest.fTraceId, "Pipeline Creation", "gpu", fragmentShader->getName());
 
-  // scheduling the next one if there is a pending one
-  if(!fPendingCompilationRequests.empty())
+  fInFlightCompilationCount--;
+
+  // the shader may have been modified (or recompiled) while the pipeline was being created
+  if(!iRequest.isSuperseded() && fragmentShader->isLinking())
   {
-    auto shader = fPendingCompilationRequests.front();
-    fPendingCompilationRequests.erase(fPendingCompilationRequests.begin());
-    shader->fState = FragmentShader::State::NotCompiled{};
-    compile(std::move(shader));
+    if(iStatus != wgpu::CreatePipelineAsyncStatus::Success || iPipeline == nullptr)
+    {
+      fragmentShader->setCompilationError({
+        .fErrorMessage = fmt::printf("Validation error: Make sure there is a function called fragmentMain\n%s", iErrorMessage)
+      });
+    }
+    else
+    {
+      // the shader module of the request (the request is not superseded)
+      fRenderPipelineCache.put(iRequest.fRenderPipelineKey,
+                               {.fRenderPipeline = iPipeline, .fShaderModule = fragmentShader->fShaderModule},
+                               fragmentShader->getCode().size() + kRenderPipelineCostEstimate);
+      if(iRequest.hasSameConstants())
+        fragmentShader->setCandidateRenderPipeline(std::move(iPipeline));
+      else
+        // the constants changed while the pipeline was being created (they are never changed while it is in flight):
+        // a new one is needed with the latest constants (from the same module)
+        fragmentShader->fState = FragmentShader::State::NotCompiled{};
+    }
   }
+
+  // scheduling the next ones if there are pending ones
+  scheduleNextCompilations();
 }
 
 //------------------------------------------------------------------------
@@ -357,6 +592,7 @@ void FragmentShaderWindow::onShaderCompilationResult(std::shared_ptr<FragmentSha
 void FragmentShaderWindow::setCurrentFragmentShader(std::shared_ptr<FragmentShader> iFragmentShader)
 {
   fCurrentFragmentShader = std::move(iFragmentShader);
+  fPassTimer->reset();
   if(fCurrentFragmentShader)
   {
     resize(fCurrentFragmentShader->getWindowSize());
@@ -381,9 +617,40 @@ void FragmentShaderWindow::beforeFrame()
   Window::beforeFrame();
 
   auto currentTime = getCurrentTime();
-  auto deltaTime = currentTime - fLastFrameCurrentTime;
-  fLastFrameCurrentTime = currentTime;
 
+  // the cost of rendering a frame is measured on the iteration of the main loop which rendered it (the time elapsed
+  // between 2 frames also depends on the cadence)
+  auto const iterationTime = currentTime - fLastIterationCurrentTime;
+  fLastIterationCurrentTime = currentTime;
+  if(std::exchange(fFrameRendered, false) && canRenderFragmentShader())
+  {
+    if(fProgressiveRendering)
+      updateProgressiveTilesPerFrame(iterationTime);
+    else if(fAdaptiveResolution)
+      updateRenderScale(iterationTime);
+  }
+
+  // [Cadence] the inputs only change for the frames actually rendered: the time of the iterations skipped
+  // accumulates so that time stays correct (and frame counts the frames rendered)
+  if(isFrameDue())
+  {
+    updateInputs(currentTime - fLastFrameCurrentTime);
+    fLastFrameCurrentTime = currentTime;
+  }
+
+  if(fCurrentFragmentShader && fCurrentFragmentShader->isEnabled() && fCurrentFragmentShader->isNotCompiled())
+    compile(fCurrentFragmentShader);
+
+  warmUpNextShaders();
+
+  captureFrames();
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::updateInputs
+//------------------------------------------------------------------------
+void FragmentShaderWindow::updateInputs(double iDeltaTime)
+{
   if(glfwGetMouseButton(fWindow, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS)
   {
     if(fMouseClick.x == -1)
@@ -398,22 +665,58 @@ void FragmentShaderWindow::beforeFrame()
 
   if(fCurrentFragmentShader && fCurrentFragmentShader->isEnabled())
   {
-    if(fCurrentFragmentShader->isCompiled())
+    // the candidate replaces the current pipeline at a frame boundary: time only starts over for the first one
+    // so that a new version can be compared with the previous one at the same point in time
+    if(fCurrentFragmentShader->hasCandidateRenderPipeline())
+    {
+      auto const isFirstRenderPipeline = !fCurrentFragmentShader->hasRenderPipeline();
+      fCurrentFragmentShader->swapInCandidateRenderPipeline();
+      if(isFirstRenderPipeline)
+        initFragmentShader(fCurrentFragmentShader);
+    }
+
+    // keeps running the current pipeline while a new version is being compiled (or fails to compile)
+    if(fCurrentFragmentShader->hasRenderPipeline())
     {
       glfwGetWindowContentScale(fWindow, &fContentScale.x, &fContentScale.y);
 
-      fCurrentFragmentShader->tickTime(deltaTime);
+      fCurrentFragmentShader->tickTime(iDeltaTime);
 
       fCurrentFragmentShader->fInputs.size = {
-        static_cast<float>(fFrameBufferSize.width), static_cast<float>(fFrameBufferSize.height),
+        static_cast<float>(fRenderSize.width), static_cast<float>(fRenderSize.height),
         fContentScale.x, fContentScale.y
       };
       fCurrentFragmentShader->fInputs.mouse.z = fMouseClick.x;
       fCurrentFragmentShader->fInputs.mouse.w = fMouseClick.y;
     }
+  }
+}
 
-    if(fCurrentFragmentShader->isNotCompiled())
-      compile(fCurrentFragmentShader);
+//------------------------------------------------------------------------
+// FragmentShaderWindow::warmUp
+//------------------------------------------------------------------------
+void FragmentShaderWindow::warmUp(std::vector<std::shared_ptr<FragmentShader>> const &iFragmentShaders)
+{
+  fWarmUpQueue.clear();
+  for(auto const &fragmentShader: iFragmentShaders)
+    fWarmUpQueue.emplace_back(fragmentShader);
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::warmUpNextShaders
+//------------------------------------------------------------------------
+void FragmentShaderWindow::warmUpNextShaders()
+{
+  auto const start = getCurrentTime();
+  while(!fWarmUpQueue.empty() &&
+        fInFlightCompilationCount < fMaxInFlightCompilations &&
+        getCurrentTime() - start < fWarmUpFrameBudget)
+  {
+    auto fragmentShader = fWarmUpQueue.front().lock();
+    fWarmUpQueue.pop_front();
+    // skips shaders that have been deleted or that are already compiled/compiling (current shader, edits...)
+    if(fragmentShader && fragmentShader->isNotCompiled())
+      compile(std::move(fragmentShader));
   }
 }
 
@@ -422,16 +725,492 @@ void FragmentShaderWindow::beforeFrame()
 //------------------------------------------------------------------------
 void FragmentShaderWindow::doRender(wgpu::RenderPassEncoder &iRenderPass)
 {
-  if(fCurrentFragmentShader && fCurrentFragmentShader->isEnabled() && fCurrentFragmentShader->isCompiled())
+  fLastRenderedState = computeRenderedState();
+
+  if(fRenderTargetView)
+    blitRenderTarget(iRenderPass);
+  else
+    renderFragmentShader(iRenderPass);
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::render
+//------------------------------------------------------------------------
+void FragmentShaderWindow::render()
+{
+  auto const inputsUploadCount = fInputsUploadCount;
+
+  // [Adaptive resolution] the shader first renders into the (smaller) render target which is then upscaled to the
+  // surface (in doRender)
+  // [Progressive rendering] only a few tiles are rendered into the (persistent) render target
+  if(fRenderTargetView)
+  {
+    if(fProgressiveRendering)
+    {
+      renderFragmentShaderTiles();
+    }
+    else
+    {
+      fGPU->renderPass(fClearColor, [this](wgpu::RenderPassEncoder &iRenderPass) {
+        renderFragmentShader(iRenderPass);
+      }, fRenderTargetView, wgpu::LoadOp::Clear, fPassTimer.get());
+    }
+  }
+  Window::render();
+  fFrameRendered = true;
+  fInputsUploadCountLastFrame = fInputsUploadCount - inputsUploadCount;
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::afterFrame
+//------------------------------------------------------------------------
+void FragmentShaderWindow::afterFrame()
+{
+  Window::afterFrame();
+  // the frame has been submitted: the timestamps of the measured pass can be read back
+  fPassTimer->readback();
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::getGPUFrameTime
+//------------------------------------------------------------------------
+FragmentShaderWindow::GPUFrameTime FragmentShaderWindow::getGPUFrameTime() const
+{
+  if(fPassTimer->isAvailable())
+    return {.fMilliseconds = fPassTimer->getHistory().computeSummary().fAvg, .fTimestampQuery = true};
+  else
+    return {.fMilliseconds = fGPU->getFrameLatency() * 1000.0, .fTimestampQuery = false};
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::canRenderFragmentShader
+//------------------------------------------------------------------------
+bool FragmentShaderWindow::canRenderFragmentShader() const
+{
+  return fCurrentFragmentShader && fCurrentFragmentShader->isEnabled() && fCurrentFragmentShader->hasRenderPipeline();
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::uploadInputs
+// Returns the slot containing the inputs
+//------------------------------------------------------------------------
+int FragmentShaderWindow::uploadInputs()
+{
+  auto const &inputs = fCurrentFragmentShader->fInputs;
+
+  // nothing changed (paused clock, no mouse movement...): the slot already contains these inputs
+  if(!fUploadedInputs || std::memcmp(&inputs, &fUploadedInputs.value(), sizeof(FragmentShader::ShaderToyInputs)) != 0)
   {
+    fShaderToyInputsSlot = (fShaderToyInputsSlot + 1) % kInputsRingSize;
     fGPU->getDevice().GetQueue().WriteBuffer(fShaderToyInputsBuffer,
-                                             0,
-                                             &fCurrentFragmentShader->fInputs,
+                                             fShaderToyInputsSlot * fShaderToyInputsSlotSize,
+                                             &inputs,
                                              sizeof(FragmentShader::ShaderToyInputs));
-    iRenderPass.SetPipeline(fCurrentFragmentShader->getRenderPipeline());
-    iRenderPass.SetBindGroup(0, fGroup0BindGroup);
-    iRenderPass.Draw(6);
+    fUploadedInputs = inputs;
+    fInputsUploadCount++;
+  }
+
+  return fShaderToyInputsSlot;
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::getRenderBundle
+//------------------------------------------------------------------------
+wgpu::RenderBundle const &FragmentShaderWindow::getRenderBundle(int iInputsSlot)
+{
+  auto &fragmentShader = *fCurrentFragmentShader;
+
+  // the bundles are cleared when the pipeline changes (FragmentShader::swapInCandidateRenderPipeline)
+  if(fragmentShader.fRenderBundlesBindGroup != fGroup0BindGroup.Get())
+  {
+    fragmentShader.fRenderBundles.clear();
+    fragmentShader.fRenderBundlesBindGroup = fGroup0BindGroup.Get();
+  }
+
+  if(fragmentShader.fRenderBundles.empty())
+  {
+    wgpu::RenderBundleEncoderDescriptor renderBundleEncoderDescriptor{
+      .label = "FragmentShaderWindow | Render Bundle Encoder",
+      .colorFormatCount = 1,
+      .colorFormats = &fPreferredFormat
+    };
+
+    for(int slot = 0; slot < kInputsRingSize; slot++)
+    {
+      auto encoder = fGPU->getDevice().CreateRenderBundleEncoder(&renderBundleEncoderDescriptor);
+      std::uint32_t offset = slot * fShaderToyInputsSlotSize;
+      encoder.SetPipeline(fragmentShader.getRenderPipeline());
+      encoder.SetBindGroup(0, fGroup0BindGroup, 1, &offset);
+      encoder.Draw(6);
+      fragmentShader.fRenderBundles.emplace_back(encoder.Finish());
+    }
   }
+
+  return fragmentShader.fRenderBundles[iInputsSlot];
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::renderFragmentShader
+//------------------------------------------------------------------------
+void FragmentShaderWindow::renderFragmentShader(wgpu::RenderPassEncoder &iRenderPass)
+{
+  if(canRenderFragmentShader())
+  {
+    auto const &renderBundle = getRenderBundle(uploadInputs());
+    iRenderPass.ExecuteBundles(1, &renderBundle);
+  }
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::renderFragmentShaderTiles
+//------------------------------------------------------------------------
+void FragmentShaderWindow::renderFragmentShaderTiles()
+{
+  fProgressiveTilesRenderedLastFrame = 0;
+
+  // any change (time, mouse, pipeline...) starts a new cycle: the tiles from the previous one remain visible until
+  // they get replaced
+  auto state = computeRenderedState();
+  if(state != fProgressiveRenderedState)
+  {
+    fProgressiveRenderedState = state;
+    fProgressiveRenderedTileCount = 0;
+  }
+
+  // every tile has been rendered with the current inputs (time is paused): the image is complete
+  if(isProgressiveRenderingComplete())
+    return;
+
+  auto const loadOp = std::exchange(fRenderTargetNeedsClear, false) ? wgpu::LoadOp::Clear : wgpu::LoadOp::Load;
+
+  if(!canRenderFragmentShader())
+  {
+    fGPU->renderPass(fClearColor, [](wgpu::RenderPassEncoder &) {}, fRenderTargetView);
+    fProgressiveRenderedTileCount = fProgressiveTileCount;
+    return;
+  }
+
+  auto const tileCount = std::min(fProgressiveTilesPerFrame, fProgressiveTileCount - fProgressiveRenderedTileCount);
+
+  fGPU->renderPass(fClearColor, [this, tileCount](wgpu::RenderPassEncoder &iRenderPass) {
+    // the scissor rect is a state of the pass (not of the bundle) so the same bundle renders each tile
+    auto const &renderBundle = getRenderBundle(uploadInputs());
+    for(int i = 0; i < tileCount; i++)
+    {
+      auto const tile = static_cast<int>(static_cast<std::int64_t>(fProgressiveTileIndex) * fProgressiveTileStride %
+                                         fProgressiveTileCount);
+      fProgressiveTileIndex = (fProgressiveTileIndex + 1) % fProgressiveTileCount;
+      auto const x = (tile % fProgressiveTileColumns) * kProgressiveTileSize;
+      auto const y = (tile / fProgressiveTileColumns) * kProgressiveTileSize;
+      iRenderPass.SetScissorRect(static_cast<uint32_t>(x),
+                                 static_cast<uint32_t>(y),
+                                 static_cast<uint32_t>(std::min(kProgressiveTileSize, fRenderSize.width - x)),
+                                 static_cast<uint32_t>(std::min(kProgressiveTileSize, fRenderSize.height - y)));
+      iRenderPass.ExecuteBundles(1, &renderBundle);
+    }
+  }, fRenderTargetView, loadOp, fPassTimer.get());
+
+  fProgressiveRenderedTileCount += tileCount;
+  fProgressiveTilesRenderedLastFrame = tileCount;
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::blitRenderTarget
+//------------------------------------------------------------------------
+void FragmentShaderWindow::blitRenderTarget(wgpu::RenderPassEncoder &iRenderPass)
+{
+  iRenderPass.SetPipeline(fBlitRenderPipeline);
+  iRenderPass.SetBindGroup(0, fBlitBindGroup);
+  iRenderPass.Draw(3);
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::setAdaptiveResolution
+//------------------------------------------------------------------------
+void FragmentShaderWindow::setAdaptiveResolution(bool iAdaptiveResolution)
+{
+  fAdaptiveResolution = iAdaptiveResolution;
+  fRenderScale = 1.0f;
+  fAverageFrameTime = 0;
+  fFramesSinceRenderScaleChange = 0;
+  updateRenderTarget();
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::setProgressiveRendering
+//------------------------------------------------------------------------
+void FragmentShaderWindow::setProgressiveRendering(bool iProgressiveRendering)
+{
+  fProgressiveRendering = iProgressiveRendering;
+  fProgressiveTilesPerFrame = kDefaultProgressiveTilesPerFrame;
+  fProgressiveRenderedState = {};
+  updateRenderTarget();
+  updateProgressiveTiles();
+  requestRender();
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::getProgressiveCompletion
+//------------------------------------------------------------------------
+float FragmentShaderWindow::getProgressiveCompletion() const
+{
+  if(fProgressiveTileCount == 0)
+    return 1.0f;
+  return std::min(1.0f, static_cast<float>(fProgressiveRenderedTileCount) / static_cast<float>(fProgressiveTileCount));
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::updateProgressiveTilesPerFrame
+//------------------------------------------------------------------------
+void FragmentShaderWindow::updateProgressiveTilesPerFrame(double iFrameTime)
+{
+  // only the frames which rendered tiles are representative of their cost (a complete image renders nothing)
+  if(fProgressiveTilesRenderedLastFrame == 0)
+    return;
+
+  // backs off quickly (a frame taking too long can trigger the GPU watchdog) but grows slowly
+  if(iFrameTime > fTargetFrameTime * 1.2)
+    fProgressiveTilesPerFrame = std::max(1, fProgressiveTilesPerFrame / 2);
+  else if(iFrameTime < fTargetFrameTime * 0.8 && fProgressiveTilesRenderedLastFrame == fProgressiveTilesPerFrame)
+    fProgressiveTilesPerFrame = std::clamp(fProgressiveTilesPerFrame + std::max(1, fProgressiveTilesPerFrame / 4),
+                                           1,
+                                           std::max(1, fProgressiveTileCount));
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::updateProgressiveTiles
+//------------------------------------------------------------------------
+void FragmentShaderWindow::updateProgressiveTiles()
+{
+  fProgressiveTileColumns = (fRenderSize.width + kProgressiveTileSize - 1) / kProgressiveTileSize;
+  auto const rows = (fRenderSize.height + kProgressiveTileSize - 1) / kProgressiveTileSize;
+  fProgressiveTileCount = fProgressiveTileColumns * rows;
+
+  // a stride close to the golden ratio spreads consecutive tiles across the image and, being co-prime with the
+  // number of tiles, visits each tile exactly once per cycle
+  auto stride = std::max(1, static_cast<int>(fProgressiveTileCount * 0.618));
+  while(std::gcd(stride, fProgressiveTileCount) != 1)
+    stride++;
+  fProgressiveTileStride = stride;
+  fProgressiveTileIndex = 0;
+  fProgressiveRenderedTileCount = 0;
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::updateRenderScale
+//------------------------------------------------------------------------
+void FragmentShaderWindow::updateRenderScale(double iFrameTime)
+{
+  fAverageFrameTime = fAverageFrameTime == 0 ? iFrameTime : fAverageFrameTime * 0.9 + iFrameTime * 0.1;
+
+  if(++fFramesSinceRenderScaleChange < kRenderScaleFrameCount)
+    return;
+
+  auto renderScale = fRenderScale;
+  if(fAverageFrameTime > fTargetFrameTime * 1.2)
+  {
+    // the cost is proportional to the number of pixels (scale^2)
+    renderScale = fRenderScale * static_cast<float>(std::sqrt(fTargetFrameTime / fAverageFrameTime));
+  }
+  else if(fAverageFrameTime < fTargetFrameTime * 0.8)
+    renderScale = fRenderScale * 1.1f;
+
+  // quantized to avoid re-creating the render target for tiny changes
+  renderScale = std::clamp(std::round(renderScale * 32.0f) / 32.0f, kMinRenderScale, 1.0f);
+  if(renderScale != fRenderScale)
+  {
+    fRenderScale = renderScale;
+    fFramesSinceRenderScaleChange = 0;
+    updateRenderTarget();
+  }
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::updateRenderTarget
+//------------------------------------------------------------------------
+void FragmentShaderWindow::updateRenderTarget()
+{
+  auto const renderScale = getRenderScale();
+
+  // full resolution: the shader renders directly into the surface (progressive rendering always needs the
+  // render target since tiles accumulate)
+  if(renderScale >= 1.0f && !fProgressiveRendering)
+  {
+    fRenderTarget = nullptr;
+    fRenderTargetView = nullptr;
+    fBlitBindGroup = nullptr;
+    fRenderSize = fFrameBufferSize;
+    return;
+  }
+
+  Renderable::Size size{
+    std::max(1, static_cast<int>(std::lround(static_cast<float>(fFrameBufferSize.width) * renderScale))),
+    std::max(1, static_cast<int>(std::lround(static_cast<float>(fFrameBufferSize.height) * renderScale)))
+  };
+
+  if(fRenderTarget && size.width == fRenderSize.width && size.height == fRenderSize.height)
+    return;
+
+  fRenderSize = size;
+
+  auto device = fGPU->getDevice();
+
+  wgpu::TextureDescriptor textureDescriptor{
+    .label = "FragmentShaderWindow | Render Target",
+    .usage = wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::TextureBinding,
+    .dimension = wgpu::TextureDimension::e2D,
+    .size = {static_cast<uint32_t>(size.width), static_cast<uint32_t>(size.height), 1},
+    .format = fPreferredFormat
+  };
+  fRenderTarget = device.CreateTexture(&textureDescriptor);
+  fRenderTargetView = fRenderTarget.CreateView();
+  fRenderTargetNeedsClear = true;
+  updateProgressiveTiles();
+
+  wgpu::BindGroupEntry blitBindGroupEntries[] = {
+    { .binding = 0, .sampler = fBlitSampler },
+    { .binding = 1, .textureView = fRenderTargetView },
+  };
+
+  wgpu::BindGroupDescriptor blitBindGroupDescriptor = {
+    .label = "FragmentShaderWindow | Blit Bind Group",
+    .layout = fBlitBindGroupLayout,
+    .entryCount = 2,
+    .entries = blitBindGroupEntries
+  };
+
+  fBlitBindGroup = device.CreateBindGroup(&blitBindGroupDescriptor);
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::computeRenderedState
+//------------------------------------------------------------------------
+FragmentShaderWindow::RenderedState FragmentShaderWindow::computeRenderedState() const
+{
+  if(!fCurrentFragmentShader)
+    return {};
+
+  return {
+    .fFragmentShader = fCurrentFragmentShader.get(),
+    .fRenderPipeline = fCurrentFragmentShader->getRenderPipeline().Get(),
+    .fEnabled = fCurrentFragmentShader->isEnabled(),
+    .fInputs = fCurrentFragmentShader->getInputs()
+  };
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::RenderedState::operator==
+//------------------------------------------------------------------------
+bool FragmentShaderWindow::RenderedState::operator==(RenderedState const &iOther) const
+{
+  return fFragmentShader == iOther.fFragmentShader &&
+         fRenderPipeline == iOther.fRenderPipeline &&
+         fEnabled == iOther.fEnabled &&
+         std::memcmp(&fInputs, &iOther.fInputs, sizeof(FragmentShader::ShaderToyInputs)) == 0;
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::saveHiResScreenshot
+//------------------------------------------------------------------------
+void FragmentShaderWindow::saveHiResScreenshot(Renderable::Size const &iSize,
+                                               std::string const &iFilename,
+                                               std::string const &iType,
+                                               float iQuality)
+{
+  if(!fCurrentFragmentShader || !fCurrentFragmentShader->hasRenderPipeline())
+    return;
+
+  fHiResScreenshot->start(*fCurrentFragmentShader, {
+    .fSize = iSize,
+    .fFilename = iFilename,
+    .fMimeType = iType,
+    .fQuality = iQuality,
+    .fClearColor = fClearColor
+  });
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::exportFrames
+//------------------------------------------------------------------------
+void FragmentShaderWindow::exportFrames(FrameCapture::Request iRequest)
+{
+  cancelFramesExport();
+
+  if(!canRenderFragmentShader())
+    return;
+
+  fFramesExportFragmentShader = fCurrentFragmentShader;
+  fFramesExportWasManualClock = fCurrentFragmentShader->isManualClock();
+  fCurrentFragmentShader->startManualClock();
+  fCurrentFragmentShader->resetTime();
+  fFrameCapture->start(std::move(iRequest));
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::cancelFramesExport
+//------------------------------------------------------------------------
+void FragmentShaderWindow::cancelFramesExport()
+{
+  fFrameCapture->cancel();
+  endFramesExport();
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::endFramesExport
+//------------------------------------------------------------------------
+void FragmentShaderWindow::endFramesExport()
+{
+  if(fFramesExportFragmentShader)
+  {
+    if(!fFramesExportWasManualClock)
+      fFramesExportFragmentShader->endManualClock();
+    fFramesExportFragmentShader = nullptr;
+  }
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::captureFrames
+// Renders as many frames as there are staging buffers available (never waits for the GPU)
+//------------------------------------------------------------------------
+void FragmentShaderWindow::captureFrames()
+{
+  if(!fFramesExportFragmentShader)
+    return;
+
+  // the export stops when complete, or when the shader changes or can no longer render
+  if(!fFrameCapture->isInProgress() ||
+     fFramesExportFragmentShader != fCurrentFragmentShader ||
+     !canRenderFragmentShader())
+  {
+    cancelFramesExport();
+    return;
+  }
+
+  // resumes when the window is visible again
+  if(fRenderSize.width <= 0 || fRenderSize.height <= 0)
+    return;
+
+  auto const timeDelta = 1.0 / static_cast<double>(fFrameCapture->getRequest().fFPS);
+  while(fFrameCapture->isReadyForNextFrame())
+  {
+    if(fFrameCapture->getNextFrame() > 0)
+      fCurrentFragmentShader->tickFrame(1, timeDelta);
+    auto const &renderBundle = getRenderBundle(uploadInputs());
+    fFrameCapture->captureNextFrame(fRenderSize, fClearColor, [&renderBundle](wgpu::RenderPassEncoder &iRenderPass) {
+      iRenderPass.ExecuteBundles(1, &renderBundle);
+    });
+  }
+}
+
+//------------------------------------------------------------------------
+// FragmentShaderWindow::isDirty
+// A running clock changes the inputs (time/frame) so it is always dirty. A progressive image is dirty until all
+// its tiles have been rendered.
+//------------------------------------------------------------------------
+bool FragmentShaderWindow::isDirty() const
+{
+  return computeRenderedState() != fLastRenderedState ||
+         (fProgressiveRendering && !isProgressiveRenderingComplete());
 }
 
 //------------------------------------------------------------------------
@@ -441,10 +1220,11 @@ void FragmentShaderWindow::doHandleFrameBufferSizeChange(Renderable::Size const
 {
   Window::doHandleFrameBufferSizeChange(iSize);
   fFrameBufferSize = iSize;
+  updateRenderTarget();
   if(fCurrentFragmentShader && fCurrentFragmentShader->isEnabled())
   {
-    fCurrentFragmentShader->fInputs.size.x = static_cast<float>(fFrameBufferSize.width);
-    fCurrentFragmentShader->fInputs.size.y = static_cast<float>(fFrameBufferSize.height);
+    fCurrentFragmentShader->fInputs.size.x = static_cast<float>(fRenderSize.width);
+    fCurrentFragmentShader->fInputs.size.y = static_cast<float>(fRenderSize.height);
     fCurrentFragmentShader->setWindowSize(getSize());
   }
 }
@@ -20,9 +20,16 @@
 #define WGPU_SHADER_TOY_FRAGMENT_SHADER_WINDOW_H
 
 #include <imgui.h>
+#include <deque>
+#include <vector>
 #include "gpu/Window.h"
 #include "Preferences.h"
 #include "FragmentShader.h"
+#include "HiResScreenshot.h"
+#include "FrameCapture.h"
+#include "utils/Hash.h"
+#include "utils/LRUCache.h"
+#include "utils/Trace.h"
 
 using namespace pongasoft;
 
@@ -38,49 +45,250 @@ class FragmentShaderWindow : public gpu::Window, public std::enable_shared_from_
 {
 public:
   static constexpr auto kPreferencesSizeKey = "shader_toy::FragmentShaderWindow::Size";
+  static constexpr int kDefaultMaxInFlightCompilations = 4;
+  // the actual (GPU) size of a pipeline is unknown, so the cost of an entry is the size of its source plus an estimate
+  static constexpr std::size_t kRenderPipelineCostEstimate = 64 * 1024;
+  static constexpr std::size_t kDefaultRenderPipelineCacheBudget = 32 * 1024 * 1024;
+  // maximum time (in seconds) spent starting warm-up compilations per frame
+  static constexpr double kDefaultWarmUpFrameBudget = 0.002;
+  // [Adaptive resolution] the render scale is adjusted (at most every kRenderScaleFrameCount frames) to keep the
+  // (smoothed) frame time within the target
+  static constexpr float kMinRenderScale = 0.25f;
+  static constexpr int kRenderScaleFrameCount = 30;
+  static constexpr double kDefaultTargetFrameTime = 1.0 / 30.0;
+  // [Progressive rendering] the shader renders a few tiles per frame (the number of tiles is adjusted to keep the
+  // frame time within the target)
+  static constexpr int kProgressiveTileSize = 64;
+  static constexpr int kDefaultProgressiveTilesPerFrame = 4;
+  // [Inputs] the inputs are uploaded (into the next slot of a small ring bound with a dynamic offset) only when they
+  // change, so that a slot is never overwritten while a previous frame may still be using it
+  static constexpr int kInputsRingSize = 3;
+
+  // One compilation request (a shader at a given generation of its code)
+  struct CompilationRequest
+  {
+    std::shared_ptr<FragmentShader> fFragmentShader;
+    FragmentShader::generation_t fGeneration{};
+    utils::hash::hash_t fRenderPipelineKey{};
+    utils::hash::hash_t fConstantsKey{};
+    // [Trace] the asynchronous span (compilation or pipeline creation) in progress
+    utils::trace::id_t fTraceId{};
+
+    // a request is superseded as soon as the code of the shader changes
+    inline bool isSuperseded() const { return fGeneration != fFragmentShader->getGeneration(); }
+    // the constants (override values) can change without changing the code (only the pipeline is then obsolete)
+    inline bool hasSameConstants() const { return fConstantsKey == fFragmentShader->getConstantsKey(); }
+  };
 
 public:
   FragmentShaderWindow(std::shared_ptr<gpu::GPU> iGPU, Window::Args const &iWindowArgs);
   ~FragmentShaderWindow() override;
 
   void beforeFrame() override;
+  void render() override;
+  void afterFrame() override;
 
   void compile(std::shared_ptr<FragmentShader> iFragmentShader);
   void setCurrentFragmentShader(std::shared_ptr<FragmentShader> iFragmentShader);
 
+  constexpr int getMaxInFlightCompilations() const { return fMaxInFlightCompilations; }
+  void setMaxInFlightCompilations(int iMaxInFlightCompilations);
+  constexpr int getInFlightCompilationCount() const { return fInFlightCompilationCount; }
+  inline auto getPendingCompilationCount() const { return fPendingCompilationRequests.size(); }
+  void setRenderPipelineCacheBudget(std::size_t iBudget) { fRenderPipelineCache.setBudget(iBudget); }
+
+  // compiles the shaders in the background (in the order provided), only when a compilation slot is free
+  void warmUp(std::vector<std::shared_ptr<FragmentShader>> const &iFragmentShaders);
+  constexpr double getWarmUpFrameBudget() const { return fWarmUpFrameBudget; }
+  constexpr void setWarmUpFrameBudget(double iBudget) { fWarmUpFrameBudget = iBudget; }
+  inline auto getWarmUpPendingCount() const { return fWarmUpQueue.size(); }
+
+  constexpr bool isAdaptiveResolution() const { return fAdaptiveResolution; }
+  void setAdaptiveResolution(bool iAdaptiveResolution);
+  constexpr double getTargetFrameTime() const { return fTargetFrameTime; }
+  constexpr void setTargetFrameTime(double iTargetFrameTime) { fTargetFrameTime = iTargetFrameTime; }
+  // the scale of the resolution the shader renders at (1.0 when rendering at full resolution)
+  constexpr float getRenderScale() const { return fAdaptiveResolution ? fRenderScale : 1.0f; }
+  constexpr Renderable::Size const &getRenderSize() const { return fRenderSize; }
+
+  constexpr bool isProgressiveRendering() const { return fProgressiveRendering; }
+  void setProgressiveRendering(bool iProgressiveRendering);
+  constexpr int getProgressiveTilesPerFrame() const { return fProgressiveTilesPerFrame; }
+  // ratio of tiles rendered since the inputs last changed (1.0 once the image is complete)
+  float getProgressiveCompletion() const;
+
+  // [GPU timing] time (in milliseconds) the GPU spends rendering the current shader, measured with timestamp queries
+  // (`fTimestampQuery`) or, when not supported by the device, on the CPU (from submitting a frame to the GPU being
+  // done with it, which includes the UI)
+  struct GPUFrameTime
+  {
+    double fMilliseconds{};
+    bool fTimestampQuery{};
+  };
+  GPUFrameTime getGPUFrameTime() const;
+
+  constexpr std::size_t getInputsUploadCount() const { return fInputsUploadCount; }
+  constexpr std::size_t getInputsUploadCountLastFrame() const { return fInputsUploadCountLastFrame; }
+
+  // renders the current shader at an arbitrary size (tiled and offscreen) and downloads the result when done
+  void saveHiResScreenshot(Renderable::Size const &iSize,
+                           std::string const &iFilename,
+                           std::string const &iType = "image/png",
+                           float iQuality = 0.85);
+  inline bool isHiResScreenshotInProgress() const { return fHiResScreenshot->isInProgress(); }
+  inline float getHiResScreenshotProgress() const { return fHiResScreenshot->getProgress(); }
+  inline std::optional<std::string> consumeHiResScreenshotError() { return fHiResScreenshot->consumeError(); }
+
+  // exports a sequence of frames of the current shader, starting at time 0 and advancing by exactly 1/fps per frame
+  // (the clock of the shader is manual during the export)
+  void exportFrames(FrameCapture::Request iRequest);
+  void cancelFramesExport();
+  inline bool isFramesExportInProgress() const { return fFrameCapture->isInProgress(); }
+  inline int getExportedFrameCount() const { return fFrameCapture->getExportedFrameCount(); }
+  inline int getFramesExportFrameCount() const { return fFrameCapture->getRequest().fFrameCount; }
+  inline std::optional<std::string> consumeFramesExportError() { return fFrameCapture->consumeError(); }
+
 protected:
   void doRender(wgpu::RenderPassEncoder &iRenderPass) override;
+  bool isDirty() const override;
+  // the shader renders into the render target: the surface pass only blits it (and is not what is being measured)
+  gpu::PassTimer *getSurfacePassTimer() const override { return fRenderTargetView ? nullptr : fPassTimer.get(); }
 
 public: // should be private (but used in callback...)
   void doHandleFrameBufferSizeChange(Size const &iSize) override;
   void onMousePosChange(double xpos, double ypos);
   inline void onContentScaleChange(ImVec2 const &iScale) { fContentScale = iScale; }
-  void onShaderCompilationResult(std::shared_ptr<FragmentShader> const &iFragmentShader,
+  void onShaderCompilationResult(CompilationRequest const &iRequest,
                                  wgpu::ShaderModule iShaderModule,
                                  wgpu::CompilationInfoRequestStatus iStatus,
                                  WGPUCompilationInfo const *iCompilationInfo);
+  void onRenderPipelineCreated(CompilationRequest const &iRequest,
+                               wgpu::CreatePipelineAsyncStatus iStatus,
+                               wgpu::RenderPipeline iPipeline,
+                               std::string const &iErrorMessage);
+
+private:
+  // what was used to render the last frame (nothing to render when nothing changed)
+  struct RenderedState
+  {
+    FragmentShader const *fFragmentShader{};
+    WGPURenderPipeline fRenderPipeline{};
+    bool fEnabled{};
+    FragmentShader::ShaderToyInputs fInputs{};
+
+    bool operator==(RenderedState const &iOther) const;
+  };
+
+  // the module is kept with the pipeline so that a cache hit followed by a change of constants only needs a new
+  // pipeline (not a new compilation)
+  struct CachedRenderPipeline
+  {
+    wgpu::RenderPipeline fRenderPipeline{};
+    wgpu::ShaderModule fShaderModule{};
+  };
 
 private:
   void initGPU();
+  void initBlitGPU();
+  RenderedState computeRenderedState() const;
+  bool canRenderFragmentShader() const;
+  int uploadInputs();
+  wgpu::RenderBundle const &getRenderBundle(int iInputsSlot);
+  void renderFragmentShader(wgpu::RenderPassEncoder &iRenderPass);
+  void renderFragmentShaderTiles();
+  void updateProgressiveTilesPerFrame(double iFrameTime);
+  void updateProgressiveTiles();
+  constexpr bool isProgressiveRenderingComplete() const { return fProgressiveRenderedTileCount >= fProgressiveTileCount; }
+  void blitRenderTarget(wgpu::RenderPassEncoder &iRenderPass);
+  void updateRenderScale(double iFrameTime);
+  void updateRenderTarget();
+  void updateInputs(double iDeltaTime);
   void initFragmentShader(std::shared_ptr<FragmentShader> const &iFragmentShader) const;
-  inline ImVec2 adjustSize(ImVec2 const &iPos) const { return {iPos.x * fContentScale.x, iPos.y * fContentScale.y}; }
+  void startCompilation(CompilationRequest iRequest);
+  void scheduleNextCompilations();
+  void warmUpNextShaders();
+  void captureFrames();
+  void endFramesExport();
+  void createRenderPipeline(CompilationRequest const &iRequest, wgpu::ShaderModule iShaderModule);
+  utils::hash::hash_t computeRenderPipelineKey(FragmentShader const &iFragmentShader) const;
+  bool maybeUseCachedRenderPipeline(std::shared_ptr<FragmentShader> const &iFragmentShader);
+  inline ImVec2 adjustSize(ImVec2 const &iPos) const {
+    auto renderScale = getRenderScale();
+    return {iPos.x * fContentScale.x * renderScale, iPos.y * fContentScale.y * renderScale};
+  }
 
 private:
   Renderable::Size fFrameBufferSize;
+  // the size the shader renders at (smaller than the frame buffer size when the render scale is < 1)
+  Renderable::Size fRenderSize;
 
   // Common gpu part
   wgpu::BindGroupLayout fGroup0BindGroupLayout{};
+  wgpu::PipelineLayout fRenderPipelineLayout{};
   wgpu::BindGroup fGroup0BindGroup{};
   wgpu::Buffer fShaderToyInputsBuffer{};
+  std::uint32_t fShaderToyInputsSlotSize{};
+  int fShaderToyInputsSlot{};
+  std::optional<FragmentShader::ShaderToyInputs> fUploadedInputs{};
+  std::size_t fInputsUploadCount{};
+  std::size_t fInputsUploadCountLastFrame{};
   wgpu::ShaderModule fVertexShaderModule{};
 
   std::shared_ptr<FragmentShader> fCurrentFragmentShader{};
 
-  std::vector<std::shared_ptr<FragmentShader>> fPendingCompilationRequests{};
+  // requests waiting for a free compilation slot (the current shader is always scheduled first): a slot is held from
+  // the start of the compilation (or of the pipeline creation when only the constants changed) until the pipeline is
+  // created, so there is at most one request in flight per shader
+  std::deque<CompilationRequest> fPendingCompilationRequests{};
+  int fInFlightCompilationCount{};
+  int fMaxInFlightCompilations{kDefaultMaxInFlightCompilations};
+
+  // shaders to compile in the background (weak so that deleting a shader does not keep it alive)
+  std::deque<std::weak_ptr<FragmentShader>> fWarmUpQueue{};
+  double fWarmUpFrameBudget{kDefaultWarmUpFrameBudget};
+
+  // compiled pipelines keyed by the hash of their full source (and constants and target format)
+  utils::LRUCache<utils::hash::hash_t, CachedRenderPipeline> fRenderPipelineCache{kDefaultRenderPipelineCacheBudget};
 
   ImVec2 fContentScale{1.0, 1.0};
   ImVec2 fMouseClick{-1, -1};
   double fLastFrameCurrentTime{};
+  double fLastIterationCurrentTime{};
+  bool fFrameRendered{};
+  RenderedState fLastRenderedState{};
+
+  // [Adaptive resolution] offscreen render target upscaled to the surface
+  bool fAdaptiveResolution{false};
+  double fTargetFrameTime{kDefaultTargetFrameTime};
+  float fRenderScale{1.0f};
+  double fAverageFrameTime{};
+  int fFramesSinceRenderScaleChange{};
+  wgpu::Texture fRenderTarget{};
+  wgpu::TextureView fRenderTargetView{};
+  wgpu::BindGroupLayout fBlitBindGroupLayout{};
+  wgpu::BindGroup fBlitBindGroup{};
+  wgpu::Sampler fBlitSampler{};
+  wgpu::RenderPipeline fBlitRenderPipeline{};
+  bool fRenderTargetNeedsClear{};
+
+  // [Progressive rendering] tiles accumulate in the (persistent) render target, visited in an interleaved order
+  // (a stride co-prime with the number of tiles) so that the whole image refines evenly
+  bool fProgressiveRendering{false};
+  int fProgressiveTilesPerFrame{kDefaultProgressiveTilesPerFrame};
+  int fProgressiveTileColumns{};
+  int fProgressiveTileCount{};
+  int fProgressiveTileStride{1};
+  int fProgressiveTileIndex{};
+  int fProgressiveRenderedTileCount{};
+  int fProgressiveTilesRenderedLastFrame{};
+  RenderedState fProgressiveRenderedState{};
+
+  std::shared_ptr<HiResScreenshot> fHiResScreenshot{};
+
+  // [Frames export] the shader being exported (and whether its clock was manual before the export)
+  std::shared_ptr<FrameCapture> fFrameCapture{};
+  std::shared_ptr<FragmentShader> fFramesExportFragmentShader{};
+  bool fFramesExportWasManualClock{};
 };
 
 }
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include "FrameCapture.h"
+#include "Errors.h"
+#include <algorithm>
+
+namespace shader_toy {
+
+extern "C" {
+void wgpu_shader_toy_export_frame(char const *iFilename, char const *iType, float iQuality,
+                                  int iWidth, int iHeight, void const *iData, std::uint32_t iBytesPerRow, bool iBGRA);
+}
+
+//------------------------------------------------------------------------
+// FrameCapture::FrameCapture
+//------------------------------------------------------------------------
+FrameCapture::FrameCapture(std::shared_ptr<gpu::GPU> iGPU, wgpu::TextureFormat iFormat) :
+  fGPU{std::move(iGPU)},
+  fFormat{iFormat},
+  fReadbackPool{std::make_shared<gpu::ReadbackPool>(fGPU->getDevice(), kStagingBufferCount)}
+{
+}
+
+//------------------------------------------------------------------------
+// FrameCapture::start
+//------------------------------------------------------------------------
+void FrameCapture::start(Request iRequest)
+{
+  cancel();
+  fRequest = std::move(iRequest);
+  fRequest.fFrameCount = std::max(fRequest.fFrameCount, 1);
+  fRequest.fFPS = std::max(fRequest.fFPS, 1);
+  fNextFrame = 0;
+  fExportedFrameCount = 0;
+  fInProgress = true;
+}
+
+//------------------------------------------------------------------------
+// FrameCapture::cancel
+//------------------------------------------------------------------------
+void FrameCapture::cancel()
+{
+  fGeneration++;
+  fReadbackPool->cancel();
+  fInProgress = false;
+  // the texture is only needed while capturing
+  fTexture = nullptr;
+  fTextureView = nullptr;
+  fTextureSize = {};
+}
+
+//------------------------------------------------------------------------
+// FrameCapture::isReadyForNextFrame
+//------------------------------------------------------------------------
+bool FrameCapture::isReadyForNextFrame() const
+{
+  return fInProgress && fNextFrame < fRequest.fFrameCount && fReadbackPool->isAvailable();
+}
+
+//------------------------------------------------------------------------
+// FrameCapture::updateTexture
+//------------------------------------------------------------------------
+void FrameCapture::updateTexture(gpu::Renderable::Size const &iSize)
+{
+  if(fTexture && fTextureSize.width == iSize.width && fTextureSize.height == iSize.height)
+    return;
+
+  // the frames in flight keep the previous texture alive until they are copied
+  wgpu::TextureDescriptor textureDescriptor{
+    .label = "FrameCapture | Frame",
+    .usage = wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::CopySrc,
+    .dimension = wgpu::TextureDimension::e2D,
+    .size = {static_cast<uint32_t>(iSize.width), static_cast<uint32_t>(iSize.height), 1},
+    .format = fFormat
+  };
+  fTexture = fGPU->getDevice().CreateTexture(&textureDescriptor);
+  fTextureView = fTexture.CreateView();
+  fTextureSize = iSize;
+}
+
+//------------------------------------------------------------------------
+// FrameCapture::captureNextFrame
+//------------------------------------------------------------------------
+void FrameCapture::captureNextFrame(gpu::Renderable::Size const &iSize,
+                                    wgpu::Color const &iClearColor,
+                                    gpu::GPU::render_pass_fn_t const &iRenderPassFn)
+{
+  WST_INTERNAL_ASSERT(isReadyForNextFrame());
+  WST_INTERNAL_ASSERT(iSize.width > 0 && iSize.height > 0);
+
+  updateTexture(iSize);
+
+  auto encoder = fGPU->getDevice().CreateCommandEncoder();
+
+  wgpu::RenderPassColorAttachment attachment{
+    .view = fTextureView,
+    .loadOp = wgpu::LoadOp::Clear,
+    .storeOp = wgpu::StoreOp::Store,
+    .clearValue = iClearColor
+  };
+
+  wgpu::RenderPassDescriptor renderPassDescriptor{
+    .colorAttachmentCount = 1,
+    .colorAttachments = &attachment,
+  };
+
+  auto pass = encoder.BeginRenderPass(&renderPassDescriptor);
+  iRenderPassFn(pass);
+  pass.End();
+
+  fReadbackPool->submit(encoder,
+                        fTexture,
+                        static_cast<uint32_t>(iSize.width),
+                        static_cast<uint32_t>(iSize.height),
+                        [capture = weak_from_this(),
+                         generation = fGeneration,
+                         frame = fNextFrame,
+                         iSize](std::uint8_t const *iData, std::uint32_t iBytesPerRow) {
+                          if(auto c = capture.lock())
+                            c->onFrameReadback(generation, frame, iSize, iData, iBytesPerRow);
+                        });
+  fNextFrame++;
+}
+
+//------------------------------------------------------------------------
+// FrameCapture::onFrameReadback
+//------------------------------------------------------------------------
+void FrameCapture::onFrameReadback(generation_t iGeneration,
+                                   int iFrame,
+                                   gpu::Renderable::Size const &iSize,
+                                   std::uint8_t const *iData,
+                                   std::uint32_t iBytesPerRow)
+{
+  if(iGeneration != fGeneration)
+    return;
+
+  if(!iData)
+  {
+    fError = fmt::printf("Frame export: cannot read back frame %d", iFrame);
+    cancel();
+    return;
+  }
+
+  // the data is copied (synchronously) by JavaScript which then encodes the image asynchronously
+  auto const isBGRA = fFormat == wgpu::TextureFormat::BGRA8Unorm || fFormat == wgpu::TextureFormat::BGRA8UnormSrgb;
+  auto filename = fmt::printf("%s-%05d.%s", fRequest.fName, iFrame, fRequest.fExtension);
+  wgpu_shader_toy_export_frame(filename.c_str(),
+                               fRequest.fMimeType.c_str(),
+                               fRequest.fQuality,
+                               iSize.width,
+                               iSize.height,
+                               iData,
+                               iBytesPerRow,
+                               isBGRA);
+
+  // done: releases the texture
+  if(++fExportedFrameCount == fRequest.fFrameCount)
+    cancel();
+}
+
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#ifndef WGPU_SHADER_TOY_FRAME_CAPTURE_H
+#define WGPU_SHADER_TOY_FRAME_CAPTURE_H
+
+#include <webgpu/webgpu_cpp.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include "gpu/GPU.h"
+#include "gpu/Renderable.h"
+#include "gpu/ReadbackPool.h"
+
+namespace shader_toy {
+
+/**
+ * Captures a sequence of frames (rendered offscreen at the size of the shader) and exports each one as an image.
+ *
+ * The caller renders the frames (`captureNextFrame`) with the clock of the shader in manual mode, advancing it by
+ * exactly 1/fps between frames, so the sequence is deterministic: frames are never dropped, instead the capture is
+ * throttled by the availability of the staging buffers (`isReadyForNextFrame`) which never blocks the main loop.
+ *
+ * Each frame is handed to JavaScript as soon as it is mapped and encoded (asynchronously) by the browser, off the
+ * render path. */
+class FrameCapture : public std::enable_shared_from_this<FrameCapture>
+{
+public:
+  static constexpr int kStagingBufferCount = 4;
+
+  struct Request
+  {
+    int fFrameCount{60};
+    int fFPS{60};
+    // files are named <fName>-<frame>.<fExtension>
+    std::string fName{};
+    std::string fExtension{"png"};
+    std::string fMimeType{"image/png"};
+    float fQuality{0.85f};
+  };
+
+public:
+  FrameCapture(std::shared_ptr<gpu::GPU> iGPU, wgpu::TextureFormat iFormat);
+
+  void start(Request iRequest);
+  void cancel();
+
+  constexpr bool isInProgress() const { return fInProgress; }
+  constexpr Request const &getRequest() const { return fRequest; }
+  constexpr int getExportedFrameCount() const { return fExportedFrameCount; }
+  // the next frame to render (in [0, frame count])
+  constexpr int getNextFrame() const { return fNextFrame; }
+  bool isReadyForNextFrame() const;
+  std::optional<std::string> consumeError() { return std::exchange(fError, std::nullopt); }
+
+  // renders the next frame offscreen (using `iRenderPassFn`) and reads it back
+  void captureNextFrame(gpu::Renderable::Size const &iSize,
+                        wgpu::Color const &iClearColor,
+                        gpu::GPU::render_pass_fn_t const &iRenderPassFn);
+
+private:
+  using generation_t = std::uint64_t;
+
+  void onFrameReadback(generation_t iGeneration,
+                       int iFrame,
+                       gpu::Renderable::Size const &iSize,
+                       std::uint8_t const *iData,
+                       std::uint32_t iBytesPerRow);
+  void updateTexture(gpu::Renderable::Size const &iSize);
+
+private:
+  std::shared_ptr<gpu::GPU> fGPU;
+  wgpu::TextureFormat fFormat;
+  std::shared_ptr<gpu::ReadbackPool> fReadbackPool;
+
+  // incremented for every capture so that the frames of a cancelled one are ignored
+  generation_t fGeneration{};
+  bool fInProgress{};
+  Request fRequest{};
+  int fNextFrame{};
+  int fExportedFrameCount{};
+  std::optional<std::string> fError{};
+
+  gpu::Renderable::Size fTextureSize{};
+  wgpu::Texture fTexture{};
+  wgpu::TextureView fTextureView{};
+};
+
+}
+
+#endif //WGPU_SHADER_TOY_FRAME_CAPTURE_H
@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include "HiResScreenshot.h"
+#include "fmt.h"
+#include "utils/WGSL.h"
+#include <algorithm>
+
+namespace shader_toy {
+
+extern "C" {
+void wgpu_shader_toy_screenshot_begin(int iWidth, int iHeight);
+void wgpu_shader_toy_screenshot_tile(int iX, int iY, int iWidth, int iHeight, void const *iData, std::uint32_t iBytesPerRow);
+void wgpu_shader_toy_screenshot_end(char const *iFilename, char const *iType, float iQuality);
+}
+
+// calls the shader entry point (which is no longer an entry point) with the position in the full image
+constexpr char kTiledEntryPoint[] = R"(
+
+@fragment
+fn wstTiledFragmentMain(@builtin(position) wstPosition: vec4f) -> @location(0) vec4f {
+  return fragmentMain(vec4f(wstPosition.xy + inputs.offset, wstPosition.zw));
+}
+)";
+
+//------------------------------------------------------------------------
+// HiResScreenshot::HiResScreenshot
+//------------------------------------------------------------------------
+HiResScreenshot::HiResScreenshot(std::shared_ptr<gpu::GPU> iGPU, Args iArgs) :
+  fGPU{std::move(iGPU)},
+  fArgs{std::move(iArgs)},
+  fReadbackPool{std::make_shared<gpu::ReadbackPool>(fGPU->getDevice(), kStagingBufferCount)}
+{
+}
+
+//------------------------------------------------------------------------
+// HiResScreenshot::~HiResScreenshot
+//------------------------------------------------------------------------
+HiResScreenshot::~HiResScreenshot()
+{
+  cancel();
+}
+
+//------------------------------------------------------------------------
+// HiResScreenshot::start
+//------------------------------------------------------------------------
+void HiResScreenshot::start(FragmentShader const &iFragmentShader, Request iRequest)
+{
+  cancel();
+
+  auto code = utils::wgsl::demoteFragmentEntryPoint(iFragmentShader.getCode(), "fragmentMain");
+  if(!code)
+  {
+    fError = "Hi-res screenshot: the shader must have a fragmentMain entry point";
+    return;
+  }
+
+  fRequest = std::move(iRequest);
+  fRequest.fSize.width = std::clamp(fRequest.fSize.width, 1, kMaxSize);
+  fRequest.fSize.height = std::clamp(fRequest.fSize.height, 1, kMaxSize);
+  fInProgress = true;
+  auto const generation = fGeneration;
+
+  // the shader renders the full (virtual) resolution: size and mouse are scaled accordingly
+  fInputs = iFragmentShader.getInputs();
+  auto const scaleX = fInputs.size.x > 0 ? static_cast<float>(fRequest.fSize.width) / fInputs.size.x : 1.0f;
+  auto const scaleY = fInputs.size.y > 0 ? static_cast<float>(fRequest.fSize.height) / fInputs.size.y : 1.0f;
+  fInputs.size.x = static_cast<float>(fRequest.fSize.width);
+  fInputs.size.y = static_cast<float>(fRequest.fSize.height);
+  fInputs.mouse.x *= scaleX;
+  fInputs.mouse.y *= scaleY;
+  if(fInputs.mouse.z >= 0)
+    fInputs.mouse.z *= scaleX;
+  if(fInputs.mouse.w >= 0)
+    fInputs.mouse.w *= scaleY;
+
+  fConstants.clear();
+  for(auto const &constant: iFragmentShader.computeConstantEntries())
+    fConstants.emplace_back(std::string(constant.key.data, constant.key.length), constant.value);
+
+  // the tiles are built row by row
+  auto const tileSize = static_cast<int>(std::min<std::uint32_t>(kMaxTileSize, [this] {
+    wgpu::Limits limits{};
+    fGPU->getDevice().GetLimits(&limits);
+    return limits.maxTextureDimension2D;
+  }()));
+  fTiles.clear();
+  for(int y = 0; y < fRequest.fSize.height; y += tileSize)
+  {
+    for(int x = 0; x < fRequest.fSize.width; x += tileSize)
+    {
+      fTiles.emplace_back(Tile{
+        .fX = x,
+        .fY = y,
+        .fWidth = std::min(tileSize, fRequest.fSize.width - x),
+        .fHeight = std::min(tileSize, fRequest.fSize.height - y)
+      });
+    }
+  }
+
+  auto shader = std::string(FragmentShader::kHeader) + *code + kTiledEntryPoint;
+
+  wgpu::ShaderSourceWGSL fragmentShaderSource{};
+  fragmentShaderSource.code = shader.c_str();
+  wgpu::ShaderModuleDescriptor fragmentShaderModuleDescriptor{
+    .nextInChain = &fragmentShaderSource,
+    .label = "HiResScreenshot | Fragment Shader"
+  };
+
+  auto shaderModule = fGPU->getDevice().CreateShaderModule(&fragmentShaderModuleDescriptor);
+  shaderModule.GetCompilationInfo(wgpu::CallbackMode::AllowProcessEvents,
+                                  [screenshot = weak_from_this(),
+                                   generation,
+                                   shaderModule](wgpu::CompilationInfoRequestStatus iStatus,
+                                                 wgpu::CompilationInfo const *iCompilationInfo) {
+                                    if(auto s = screenshot.lock())
+                                    {
+                                      s->onShaderCompilationResult(generation,
+                                                                   shaderModule,
+                                                                   iStatus,
+                                                                   reinterpret_cast<WGPUCompilationInfo const *>(iCompilationInfo));
+                                    }
+                                  });
+}
+
+//------------------------------------------------------------------------
+// HiResScreenshot::onShaderCompilationResult
+//------------------------------------------------------------------------
+void HiResScreenshot::onShaderCompilationResult(generation_t iGeneration,
+                                                wgpu::ShaderModule iShaderModule,
+                                                wgpu::CompilationInfoRequestStatus iStatus,
+                                                WGPUCompilationInfo const *iCompilationInfo)
+{
+  if(iGeneration != fGeneration)
+    return;
+
+  if(iStatus != wgpu::CompilationInfoRequestStatus::Success || !iCompilationInfo)
+  {
+    fail("Hi-res screenshot: unknown error while compiling the shader");
+    return;
+  }
+
+  for(std::size_t i = 0; i < iCompilationInfo->messageCount; i++)
+  {
+    auto &message = iCompilationInfo->messages[i];
+    if(message.type == WGPUCompilationMessageType_Error)
+    {
+      fail(fmt::printf("Hi-res screenshot: %.*s", static_cast<int>(message.message.length), message.message.data));
+      return;
+    }
+  }
+
+  std::vector<wgpu::ConstantEntry> constants{};
+  for(auto const &[key, value]: fConstants)
+    constants.emplace_back(wgpu::ConstantEntry{.key = {key.data(), key.size()}, .value = value});
+
+  // same blending as the window (the result must be identical)
+  wgpu::BlendState blendState {
+    .color {
+      .operation = wgpu::BlendOperation::Add,
+      .srcFactor = wgpu::BlendFactor::SrcAlpha,
+      .dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha,
+    },
+    .alpha {
+      .operation = wgpu::BlendOperation::Add,
+      .srcFactor = wgpu::BlendFactor::SrcAlpha,
+      .dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha,
+    }
+  };
+
+  wgpu::ColorTargetState colorTargetState{.format = fArgs.fFormat, .blend = &blendState};
+
+  wgpu::FragmentState fragmentState{
+    .module = std::move(iShaderModule),
+    .entryPoint = "wstTiledFragmentMain",
+    .constantCount = constants.size(),
+    .constants = constants.data(),
+    .targetCount = 1,
+    .targets = &colorTargetState
+  };
+
+  wgpu::RenderPipelineDescriptor renderPipelineDescriptor{
+    .label = "HiResScreenshot | Pipeline",
+    .layout = fArgs.fPipelineLayout,
+    .vertex{
+      .module = fArgs.fVertexShaderModule,
+      .entryPoint = "vertexMain"
+    },
+    .primitive = wgpu::PrimitiveState{},
+    .multisample = wgpu::MultisampleState{},
+    .fragment = &fragmentState,
+  };
+
+  fGPU->getDevice().CreateRenderPipelineAsync(&renderPipelineDescriptor,
+                                              wgpu::CallbackMode::AllowProcessEvents,
+                                              [screenshot = weak_from_this(),
+                                               iGeneration](wgpu::CreatePipelineAsyncStatus iStatus,
+                                                            wgpu::RenderPipeline iPipeline,
+                                                            auto const &iMessage) {
+                                                if(auto s = screenshot.lock())
+                                                {
+                                                  s->onRenderPipelineCreated(iGeneration,
+                                                                             iStatus,
+                                                                             std::move(iPipeline),
+                                                                             std::string(iMessage));
+                                                }
+                                              });
+}
+
+//------------------------------------------------------------------------
+// HiResScreenshot::onRenderPipelineCreated
+//------------------------------------------------------------------------
+void HiResScreenshot::onRenderPipelineCreated(generation_t iGeneration,
+                                              wgpu::CreatePipelineAsyncStatus iStatus,
+                                              wgpu::RenderPipeline iPipeline,
+                                              std::string const &iErrorMessage)
+{
+  if(iGeneration != fGeneration)
+    return;
+
+  if(iStatus != wgpu::CreatePipelineAsyncStatus::Success || iPipeline == nullptr)
+  {
+    fail(fmt::printf("Hi-res screenshot: %s", iErrorMessage));
+    return;
+  }
+
+  fRenderPipeline = std::move(iPipeline);
+  initResources();
+  wgpu_shader_toy_screenshot_begin(fRequest.fSize.width, fRequest.fSize.height);
+  renderNextTiles();
+}
+
+//------------------------------------------------------------------------
+// HiResScreenshot::initResources
+//------------------------------------------------------------------------
+void HiResScreenshot::initResources()
+{
+  auto device = fGPU->getDevice();
+
+  // every tile is rendered in the same texture (only the area of the tile is copied)
+  auto maxTileWidth = std::ranges::max(fTiles, {}, &Tile::fWidth);
+  auto maxTileHeight = std::ranges::max(fTiles, {}, &Tile::fHeight);
+
+  wgpu::TextureDescriptor textureDescriptor{
+    .label = "HiResScreenshot | Tile",
+    .usage = wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::CopySrc,
+    .dimension = wgpu::TextureDimension::e2D,
+    .size = {static_cast<uint32_t>(maxTileWidth.fWidth), static_cast<uint32_t>(maxTileHeight.fHeight), 1},
+    .format = fArgs.fFormat
+  };
+  fTileTexture = device.CreateTexture(&textureDescriptor);
+  fTileTextureView = fTileTexture.CreateView();
+
+  wgpu::BufferDescriptor inputsBufferDescriptor{
+    .label = "HiResScreenshot | ShaderToyInputs Buffer",
+    .usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform,
+    .size = (sizeof(FragmentShader::ShaderToyInputs) + 15) & ~15u
+  };
+  fInputsBuffer = device.CreateBuffer(&inputsBufferDescriptor);
+
+  wgpu::BindGroupEntry bindGroupEntries[] = {
+    { .binding = 0, .buffer = fInputsBuffer, .size = inputsBufferDescriptor.size },
+  };
+
+  wgpu::BindGroupDescriptor bindGroupDescriptor = {
+    .label = "HiResScreenshot | Group0 Bind Group",
+    .layout = fArgs.fBindGroupLayout,
+    .entryCount = 1,
+    .entries = bindGroupEntries
+  };
+  fBindGroup = device.CreateBindGroup(&bindGroupDescriptor);
+}
+
+//------------------------------------------------------------------------
+// HiResScreenshot::renderNextTiles
+//------------------------------------------------------------------------
+void HiResScreenshot::renderNextTiles()
+{
+  while(fNextTile < fTiles.size() && fReadbackPool->isAvailable())
+    renderTile(fNextTile++);
+}
+
+//------------------------------------------------------------------------
+// HiResScreenshot::renderTile
+//------------------------------------------------------------------------
+void HiResScreenshot::renderTile(std::size_t iTileIndex)
+{
+  auto device = fGPU->getDevice();
+  auto const &tile = fTiles[iTileIndex];
+
+  // the queue executes the writes and the submissions in order: each tile sees its own offset
+  fInputs.offset = {static_cast<float>(tile.fX), static_cast<float>(tile.fY)};
+  device.GetQueue().WriteBuffer(fInputsBuffer, 0, &fInputs, sizeof(FragmentShader::ShaderToyInputs));
+
+  auto encoder = device.CreateCommandEncoder();
+
+  wgpu::RenderPassColorAttachment attachment{
+    .view = fTileTextureView,
+    .loadOp = wgpu::LoadOp::Clear,
+    .storeOp = wgpu::StoreOp::Store,
+    .clearValue = fRequest.fClearColor
+  };
+
+  wgpu::RenderPassDescriptor renderPassDescriptor{
+    .colorAttachmentCount = 1,
+    .colorAttachments = &attachment,
+  };
+
+  auto pass = encoder.BeginRenderPass(&renderPassDescriptor);
+  std::uint32_t const offset = 0;
+  pass.SetPipeline(fRenderPipeline);
+  pass.SetBindGroup(0, fBindGroup, 1, &offset);
+  pass.SetScissorRect(0, 0, static_cast<uint32_t>(tile.fWidth), static_cast<uint32_t>(tile.fHeight));
+  pass.Draw(6);
+  pass.End();
+
+  fReadbackPool->submit(encoder,
+                        fTileTexture,
+                        static_cast<uint32_t>(tile.fWidth),
+                        static_cast<uint32_t>(tile.fHeight),
+                        [screenshot = weak_from_this(),
+                         generation = fGeneration,
+                         iTileIndex](std::uint8_t const *iData, std::uint32_t iBytesPerRow) {
+                          if(auto s = screenshot.lock())
+                            s->onTileReadback(generation, iTileIndex, iData, iBytesPerRow);
+                        });
+}
+
+//------------------------------------------------------------------------
+// HiResScreenshot::onTileReadback
+//------------------------------------------------------------------------
+void HiResScreenshot::onTileReadback(generation_t iGeneration,
+                                     std::size_t iTileIndex,
+                                     std::uint8_t const *iData,
+                                     std::uint32_t iBytesPerRow)
+{
+  if(iGeneration != fGeneration)
+    return;
+
+  if(!iData)
+  {
+    fail("Hi-res screenshot: cannot read back the image");
+    return;
+  }
+
+  auto const &tile = fTiles[iTileIndex];
+  wgpu_shader_toy_screenshot_tile(tile.fX, tile.fY, tile.fWidth, tile.fHeight, iData, iBytesPerRow);
+
+  if(++fCompletedTileCount == fTiles.size())
+    finish();
+  else
+    renderNextTiles();
+}
+
+//------------------------------------------------------------------------
+// HiResScreenshot::finish
+//------------------------------------------------------------------------
+void HiResScreenshot::finish()
+{
+  wgpu_shader_toy_screenshot_end(fRequest.fFilename.c_str(), fRequest.fMimeType.c_str(), fRequest.fQuality);
+  reset();
+}
+
+//------------------------------------------------------------------------
+// HiResScreenshot::fail
+//------------------------------------------------------------------------
+void HiResScreenshot::fail(std::string iError)
+{
+  fError = std::move(iError);
+  cancel();
+}
+
+//------------------------------------------------------------------------
+// HiResScreenshot::cancel
+//------------------------------------------------------------------------
+void HiResScreenshot::cancel()
+{
+  if(fInProgress)
+  {
+    // drops the image being stitched
+    wgpu_shader_toy_screenshot_end(nullptr, nullptr, 0);
+    reset();
+  }
+}
+
+//------------------------------------------------------------------------
+// HiResScreenshot::reset
+//------------------------------------------------------------------------
+void HiResScreenshot::reset()
+{
+  // pending callbacks (mapping, compilation) are now obsolete
+  fGeneration++;
+  fInProgress = false;
+  fRenderPipeline = nullptr;
+  fTileTexture = nullptr;
+  fTileTextureView = nullptr;
+  fInputsBuffer = nullptr;
+  fBindGroup = nullptr;
+  fReadbackPool->cancel();
+  fTiles.clear();
+  fNextTile = 0;
+  fCompletedTileCount = 0;
+}
+
+//------------------------------------------------------------------------
+// HiResScreenshot::getProgress
+//------------------------------------------------------------------------
+float HiResScreenshot::getProgress() const
+{
+  if(fTiles.empty())
+    return 0;
+  return static_cast<float>(fCompletedTileCount) / static_cast<float>(fTiles.size());
+}
+
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#ifndef WGPU_SHADER_TOY_HI_RES_SCREENSHOT_H
+#define WGPU_SHADER_TOY_HI_RES_SCREENSHOT_H
+
+#include <webgpu/webgpu_cpp.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <utility>
+#include "gpu/GPU.h"
+#include "gpu/Renderable.h"
+#include "gpu/ReadbackPool.h"
+#include "FragmentShader.h"
+
+namespace shader_toy {
+
+/**
+ * Renders a fragment shader at an arbitrary resolution (independent of the size of the window), one tile at a time.
+ *
+ * - each tile fits in the device texture limits: the shader sees the full (virtual) resolution in `inputs.size` and
+ *   the position of the tile in `inputs.offset` (a wrapper entry point adds it to the fragment position so that
+ *   the shader does not need to know about it)
+ * - tiles are read back (`gpu::ReadbackPool`) using 2 staging buffers (a tile is rendered while the previous one is
+ *   being read back) and stitched (in JavaScript) in an offscreen canvas: the full image never lives in GPU memory
+ *
+ * Everything is asynchronous (driven by the callbacks processed in `GPU::pollEvents`). */
+class HiResScreenshot : public std::enable_shared_from_this<HiResScreenshot>
+{
+public:
+  static constexpr int kMaxTileSize = 2048;
+  static constexpr int kStagingBufferCount = 2;
+  // browsers limit the size of a canvas
+  static constexpr int kMaxSize = 16384;
+
+  struct Args
+  {
+    wgpu::BindGroupLayout fBindGroupLayout{};
+    wgpu::PipelineLayout fPipelineLayout{};
+    wgpu::ShaderModule fVertexShaderModule{};
+    wgpu::TextureFormat fFormat{wgpu::TextureFormat::RGBA8Unorm};
+  };
+
+  struct Request
+  {
+    gpu::Renderable::Size fSize{};
+    std::string fFilename{};
+    std::string fMimeType{"image/png"};
+    float fQuality{0.85f};
+    wgpu::Color fClearColor{};
+  };
+
+public:
+  HiResScreenshot(std::shared_ptr<gpu::GPU> iGPU, Args iArgs);
+  ~HiResScreenshot();
+
+  // captures the code, constants and inputs of the shader as they are now (a screenshot in progress is cancelled)
+  void start(FragmentShader const &iFragmentShader, Request iRequest);
+  void cancel();
+
+  constexpr bool isInProgress() const { return fInProgress; }
+  // ratio of tiles read back (0 while compiling)
+  float getProgress() const;
+  std::optional<std::string> consumeError() { return std::exchange(fError, std::nullopt); }
+
+private:
+  struct Tile
+  {
+    int fX{};
+    int fY{};
+    int fWidth{};
+    int fHeight{};
+  };
+
+  using generation_t = std::uint64_t;
+
+private:
+  void onShaderCompilationResult(generation_t iGeneration,
+                                 wgpu::ShaderModule iShaderModule,
+                                 wgpu::CompilationInfoRequestStatus iStatus,
+                                 WGPUCompilationInfo const *iCompilationInfo);
+  void onRenderPipelineCreated(generation_t iGeneration,
+                               wgpu::CreatePipelineAsyncStatus iStatus,
+                               wgpu::RenderPipeline iPipeline,
+                               std::string const &iErrorMessage);
+  void onTileReadback(generation_t iGeneration,
+                      std::size_t iTileIndex,
+                      std::uint8_t const *iData,
+                      std::uint32_t iBytesPerRow);
+  void initResources();
+  void renderNextTiles();
+  void renderTile(std::size_t iTileIndex);
+  void finish();
+  void fail(std::string iError);
+  void reset();
+
+private:
+  std::shared_ptr<gpu::GPU> fGPU;
+  Args fArgs;
+
+  // incremented for every screenshot so that callbacks of a cancelled one are ignored
+  generation_t fGeneration{};
+  bool fInProgress{};
+  Request fRequest{};
+  FragmentShader::ShaderToyInputs fInputs{};
+  // copied (the keys of the entries computed by the shader point to its overrides which may change)
+  std::vector<std::pair<std::string, double>> fConstants{};
+  std::optional<std::string> fError{};
+
+  wgpu::RenderPipeline fRenderPipeline{};
+  wgpu::Texture fTileTexture{};
+  wgpu::TextureView fTileTextureView{};
+  wgpu::Buffer fInputsBuffer{};
+  wgpu::BindGroup fBindGroup{};
+  std::shared_ptr<gpu::ReadbackPool> fReadbackPool;
+
+  std::vector<Tile> fTiles{};
+  std::size_t fNextTile{};
+  std::size_t fCompletedTileCount{};
+};
+
+}
+
+#endif //WGPU_SHADER_TOY_HI_RES_SCREENSHOT_H
@@ -27,6 +27,7 @@
 #include "Errors.h"
 #include "utils/DataManager.h"
 #include <iostream>
+#include <algorithm>
 #include <ranges>
 #include <utility>
 #include <emscripten.h>
@@ -135,6 +136,51 @@ static void mergeFontAwesome()
                                  icons_ranges);
 }
 
+//------------------------------------------------------------------------
+// impl::renderCadence
+//------------------------------------------------------------------------
+static void renderCadence(char const *iLabel, gpu::Renderable &iRenderable)
+{
+  ImGui::PushID(iLabel);
+  ImGui::SeparatorText(iLabel);
+  auto cadence = iRenderable.getCadence();
+  auto changed = ImGui::SliderInt("Max FPS", &cadence.fMaxFPS, 0, 120, cadence.fMaxFPS == 0 ? "No limit" : "%d");
+  changed |= ImGui::SliderInt("Every Nth Frame", &cadence.fFrameInterval, 1, 10);
+  if(changed)
+    iRenderable.setCadence(cadence);
+  ImGui::PopID();
+}
+
+//------------------------------------------------------------------------
+// impl::renderPhaseTimings
+//------------------------------------------------------------------------
+static void renderPhaseTimings(char const *iLabel, utils::PhaseTimings const &iTimings)
+{
+  ImGui::SeparatorText(iLabel);
+  if(ImGui::BeginTable(iLabel, 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersInnerV))
+  {
+    ImGui::TableSetupColumn("Phase (ms)");
+    for(auto column: {"Last", "Min", "Avg", "P95", "P99"})
+      ImGui::TableSetupColumn(column, ImGuiTableColumnFlags_WidthFixed, ImGui::CalcTextSize("0000.00").x);
+    ImGui::TableHeadersRow();
+
+    for(auto const &[phase, history]: iTimings.getPhases())
+    {
+      auto summary = history.computeSummary();
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      ImGui::TextUnformatted(phase.c_str());
+      auto column = 1;
+      for(auto value: {summary.fLast, summary.fMin, summary.fAvg, summary.fP95, summary.fP99})
+      {
+        ImGui::TableSetColumnIndex(column++);
+        ImGui::Text("%.2f", value);
+      }
+    }
+    ImGui::EndTable();
+  }
+}
+
 }
 
 //------------------------------------------------------------------------
@@ -164,6 +210,7 @@ EM_JS(void, JSSetWindowOrder, (GLFWwindow *iLeftWindow, GLFWwindow *iRightWindow
 MainWindow::MainWindow(std::shared_ptr<GPU> iGPU, Window::Args const &iWindowArgs,
                        Args const &iMainWindowArgs) : ImGuiWindow(std::move(iGPU), iWindowArgs),
                                                       fPreferences{iMainWindowArgs.preferences},
+                                                      fMainLoopTimings{iMainWindowArgs.mainLoopTimings},
                                                       fDefaultState{iMainWindowArgs.defaultState},
                                                       fLastComputedState{Preferences::serialize(iMainWindowArgs.state)},
                                                       fLastComputedStateTime{glfwGetTime()},
@@ -172,6 +219,7 @@ MainWindow::MainWindow(std::shared_ptr<GPU> iGPU, Window::Args const &iWindowArg
                                                                                                iMainWindowArgs.fragmentShaderWindow)
                                                       }
 {
+  getPhaseTimings().setName("Main Window");
   initFromStateAction(iMainWindowArgs.state);
   loadFont();
   setFontSize(iMainWindowArgs.state.fSettings.fFontSize);
@@ -220,6 +268,45 @@ void MainWindow::setFontSize(float iFontSize)
   fFontSize = iFontSize;
 }
 
+//------------------------------------------------------------------------
+// MainWindow::setWarmUpFrameBudget
+//------------------------------------------------------------------------
+void MainWindow::setWarmUpFrameBudget(float iBudgetMs)
+{
+  fCodeWarmUpFrameBudgetMs = std::clamp(iBudgetMs, 0.0f, 10.0f);
+  fFragmentShaderWindow->setWarmUpFrameBudget(fCodeWarmUpFrameBudgetMs / 1000.0);
+}
+
+//------------------------------------------------------------------------
+// MainWindow::setAdaptiveResolutionTargetFPS
+//------------------------------------------------------------------------
+void MainWindow::setAdaptiveResolutionTargetFPS(int iTargetFPS)
+{
+  fAdaptiveResolutionTargetFPS = std::clamp(iTargetFPS, 5, 120);
+  fFragmentShaderWindow->setTargetFrameTime(1.0 / fAdaptiveResolutionTargetFPS);
+}
+
+//------------------------------------------------------------------------
+// MainWindow::warmUpFragmentShaders
+//------------------------------------------------------------------------
+void MainWindow::warmUpFragmentShaders()
+{
+  // the shaders closest to the current one (the tabs most likely to be selected next) are compiled first
+  auto current = std::ranges::find(fFragmentShaders, fCurrentFragmentShader);
+  auto index = current == fFragmentShaders.end() ? 0 : std::distance(fFragmentShaders.begin(), current);
+  auto count = static_cast<decltype(index)>(fFragmentShaders.size());
+
+  std::vector<std::shared_ptr<FragmentShader>> shaders{};
+  for(decltype(index) distance = 1; distance < count; distance++)
+  {
+    if(index + distance < count)
+      shaders.emplace_back(fFragmentShaders[index + distance]);
+    if(index - distance >= 0)
+      shaders.emplace_back(fFragmentShaders[index - distance]);
+  }
+  fFragmentShaderWindow->warmUp(shaders);
+}
+
 //------------------------------------------------------------------------
 // MainWindow::~MainWindow
 //------------------------------------------------------------------------
@@ -306,6 +393,39 @@ void MainWindow::renderSettingsMenu()
         .button("Cancel", [lineSpacing = fLineSpacing, this] { fLineSpacing = lineSpacing; });
     }
     ImGui::MenuItem("Show White Space", nullptr, &fCodeShowWhiteSpace);
+    ImGui::Separator();
+    ImGui::MenuItem("Live Compile", nullptr, &fCodeLiveCompile);
+    if(ImGui::MenuItem("Live Compile Delay"))
+    {
+      newDialog("Live Compile Delay")
+        .content([this] {
+          ImGui::Text("Compiles when the code has not changed for");
+          ImGui::SliderFloat("###live_compile_delay", &fCodeLiveCompileDelay, 0.1f, 5.0f, "%.1fs");
+        })
+        .buttonOk()
+        .button("Cancel", [delay = fCodeLiveCompileDelay, this] { fCodeLiveCompileDelay = delay; });
+    }
+    if(ImGui::MenuItem("Background Compilation"))
+    {
+      newDialog("Background Compilation")
+        .content([this] {
+          ImGui::Text("Maximum time per frame spent compiling the other shaders (0 to disable)");
+          float budget = fCodeWarmUpFrameBudgetMs;
+          if(ImGui::SliderFloat("###warm_up_frame_budget", &budget, 0.0f, 10.0f, "%.1fms"))
+            setWarmUpFrameBudget(budget);
+          ImGui::Text("Maximum number of shaders compiling at the same time");
+          int maxInFlight = fFragmentShaderWindow->getMaxInFlightCompilations();
+          if(ImGui::SliderInt("###max_in_flight_compilations", &maxInFlight, 1, 16))
+            fFragmentShaderWindow->setMaxInFlightCompilations(maxInFlight);
+        })
+        .buttonOk()
+        .button("Cancel", [budget = fCodeWarmUpFrameBudgetMs,
+                           maxInFlight = fFragmentShaderWindow->getMaxInFlightCompilations(),
+                           this] {
+          setWarmUpFrameBudget(budget);
+          fFragmentShaderWindow->setMaxInFlightCompilations(maxInFlight);
+        });
+    }
     ImGui::EndMenu();
   }
   if(ImGui::BeginMenu("Resolution"))
@@ -314,6 +434,62 @@ void MainWindow::renderSettingsMenu()
     {
       fFragmentShaderWindow->toggleHiDPIAwareness();
     }
+    // lowers the resolution of the shader when it is too slow to render
+    auto adaptiveLabel = fFragmentShaderWindow->isAdaptiveResolution() ?
+                         fmt::printf("Adaptive (%.0f%%)###adaptive", fFragmentShaderWindow->getRenderScale() * 100.0f) :
+                         std::string("Adaptive###adaptive");
+    if(ImGui::MenuItem(adaptiveLabel.c_str(), nullptr, fFragmentShaderWindow->isAdaptiveResolution()))
+      fFragmentShaderWindow->setAdaptiveResolution(!fFragmentShaderWindow->isAdaptiveResolution());
+    if(ImGui::MenuItem("Adaptive Target FPS"))
+    {
+      newDialog("Adaptive Target FPS")
+        .content([this] {
+          int fps = fAdaptiveResolutionTargetFPS;
+          if(ImGui::SliderInt("###adaptive_target_fps", &fps, 5, 120))
+            setAdaptiveResolutionTargetFPS(fps);
+        })
+        .buttonOk()
+        .button("Cancel", [fps = fAdaptiveResolutionTargetFPS, this] { setAdaptiveResolutionTargetFPS(fps); });
+    }
+    // renders only a few tiles per frame (for shaders too slow to render in one frame)
+    auto progressiveLabel = fFragmentShaderWindow->isProgressiveRendering() ?
+                            fmt::printf("Progressive (%.0f%%)###progressive",
+                                        fFragmentShaderWindow->getProgressiveCompletion() * 100.0f) :
+                            std::string("Progressive###progressive");
+    if(ImGui::MenuItem(progressiveLabel.c_str(), nullptr, fFragmentShaderWindow->isProgressiveRendering()))
+      fFragmentShaderWindow->setProgressiveRendering(!fFragmentShaderWindow->isProgressiveRendering());
+    ImGui::Separator();
+    // only renders a new frame when something changed (input, running clock, compilation, resize...)
+    if(ImGui::MenuItem("Render On Demand", nullptr, isRenderOnDemand()))
+      setRenderOnDemand(!isRenderOnDemand());
+    // the UI and the shader render at their own (independent) cadence
+    if(ImGui::MenuItem("Frame Rate"))
+    {
+      newDialog("Frame Rate")
+        .content([this] {
+          impl::renderCadence("UI", *this);
+          impl::renderCadence("Shader", *fFragmentShaderWindow);
+          ImGui::Separator();
+          ImGui::Text("GPU latency: %.1fms", fGPU->getFrameLatency() * 1000.0);
+        })
+        .buttonOk()
+        .button("Cancel", [ui = getCadence(), shader = fFragmentShaderWindow->getCadence(), this] {
+          setCadence(ui);
+          fFragmentShaderWindow->setCadence(shader);
+        });
+    }
+    // the modes supported by the shader window (the UI falls back to Fifo for the ones it does not support)
+    if(ImGui::BeginMenu("Present Mode"))
+    {
+      for(auto presentMode: fFragmentShaderWindow->getSupportedPresentModes())
+      {
+        if(ImGui::MenuItem(presentModeAsString(presentMode), nullptr, presentMode == fFragmentShaderWindow->getPresentMode()))
+          setPresentMode(presentMode);
+      }
+      ImGui::EndMenu();
+    }
+    if(ImGui::MenuItem("Opaque", nullptr, fFragmentShaderWindow->isOpaque()))
+      setOpaque(!fFragmentShaderWindow->isOpaque());
 //    if(ImGui::BeginMenu("Aspect Ratio"))
 //    {
 //      for(auto &[name, aspectRatio]: kAspectRatios)
@@ -366,6 +542,8 @@ void MainWindow::renderMainMenuBar()
         newHelpDialog();
       ImGui::SeparatorText("Settings");
       renderSettingsMenu();
+      ImGui::MenuItem("Frame Timings", nullptr, &fShowFrameTimings);
+      renderTraceMenu();
       ImGui::SeparatorText("Project | Browser");
       ImGui::MenuItem("Auto Save", nullptr, &fBrowserAutoSave);
       if(ImGui::MenuItem("Save"))
@@ -531,10 +709,51 @@ void MainWindow::renderControlsSection()
 
   ImGui::SameLine();
 
-  ImGui::Text("| %s | %.3f (%.1f FPS)",
+  auto const gpuFrameTime = fFragmentShaderWindow->getGPUFrameTime();
+  ImGui::Text("| %s | %.3f (%.1f FPS) | GPU %s%.2fms",
               fCurrentFragmentShader->getStatus(),
               1000.0f / ImGui::GetIO().Framerate,
-              ImGui::GetIO().Framerate);
+              ImGui::GetIO().Framerate,
+              gpuFrameTime.fTimestampQuery ? "" : "~",
+              gpuFrameTime.fMilliseconds);
+  if(ImGui::IsItemHovered())
+  {
+    auto stats = fGPU->getObjectCache().getStats();
+    ImGui::SetTooltip("%s\n"
+                      "Shared GPU objects: %zu\n"
+                      "  bind group layouts: %zu\n"
+                      "  pipeline layouts:   %zu\n"
+                      "  samplers:           %zu\n"
+                      "  shader modules:     %zu\n"
+                      "Cache hits/misses: %zu/%zu\n"
+                      "Inputs uploads: %zu (last frame: %zu)",
+                      gpuFrameTime.fTimestampQuery ?
+                      "GPU: time spent rendering the shader (timestamp queries)" :
+                      "GPU: ~time to render a frame, measured on the CPU (timestamp queries not supported)",
+                      stats.getLiveObjectCount(),
+                      stats.fBindGroupLayoutCount,
+                      stats.fPipelineLayoutCount,
+                      stats.fSamplerCount,
+                      stats.fShaderModuleCount,
+                      stats.fHitCount,
+                      stats.fMissCount,
+                      fFragmentShaderWindow->getInputsUploadCount(),
+                      fFragmentShaderWindow->getInputsUploadCountLastFrame());
+  }
+
+  if(fFragmentShaderWindow->isHiResScreenshotInProgress())
+  {
+    ImGui::SameLine();
+    ImGui::Text("| Screenshot %.0f%%", fFragmentShaderWindow->getHiResScreenshotProgress() * 100.0f);
+  }
+
+  if(fFragmentShaderWindow->isFramesExportInProgress())
+  {
+    ImGui::SameLine();
+    ImGui::Text("| Exporting %d/%d",
+                fFragmentShaderWindow->getExportedFrameCount(),
+                fFragmentShaderWindow->getFramesExportFrameCount());
+  }
 }
 
 
@@ -553,7 +772,7 @@ void MainWindow::compile(std::string const &iNewCode)
 //------------------------------------------------------------------------
 void MainWindow::promptNewEmtpyShader()
 {
-  maybeNewFragmentShader("New Shader", "Create", {"", kEmptyShader});
+  maybeNewFragmentShader("New Shader", "Create", {.fName = "", .fCode = kEmptyShader});
 }
 
 //------------------------------------------------------------------------
@@ -735,9 +954,22 @@ void MainWindow::exportProject()
 //------------------------------------------------------------------------
 void MainWindow::saveCurrentFragmentShaderScreenshot(std::string const &iFilename)
 {
-  fFragmentShaderWindow->saveScreenshot(fmt::printf("%s.%s", iFilename, fScreenshotFormat.fExtension),
-                                        fScreenshotFormat.fMimeType,
-                                        static_cast<float>(fScreenshotQualityPercent) / 100.0f);
+  auto filename = fmt::printf("%s.%s", iFilename, fScreenshotFormat.fExtension);
+  auto quality = static_cast<float>(fScreenshotQualityPercent) / 100.0f;
+  if(fScreenshotScale > 1)
+    fFragmentShaderWindow->saveHiResScreenshot(computeScreenshotSize(), filename, fScreenshotFormat.fMimeType, quality);
+  else
+    fFragmentShaderWindow->saveScreenshot(filename, fScreenshotFormat.fMimeType, quality);
+}
+
+//------------------------------------------------------------------------
+// MainWindow::computeScreenshotSize
+//------------------------------------------------------------------------
+gpu::Renderable::Size MainWindow::computeScreenshotSize() const
+{
+  auto size = fFragmentShaderWindow->getFrameBufferSize();
+  return {std::min(size.width * fScreenshotScale, HiResScreenshot::kMaxSize),
+          std::min(size.height * fScreenshotScale, HiResScreenshot::kMaxSize)};
 }
 
 //------------------------------------------------------------------------
@@ -768,6 +1000,11 @@ void MainWindow::promptSaveCurrentFragmentShaderScreenshot()
       if(fScreenshotFormat.fHasQuality)
         ImGui::SliderInt("Quality", &fScreenshotQualityPercent, 1, 100, "%d%%");
 
+      ImGui::SeparatorText("Resolution");
+      ImGui::SliderInt("Scale", &fScreenshotScale, 1, 8, "x%d");
+      auto size = computeScreenshotSize();
+      ImGui::Text("%dx%d%s", size.width, size.height, fScreenshotScale > 1 ? " (rendered offscreen in tiles)" : "");
+
       ImGui::SeparatorText("Time Controls");
 
       if(fCurrentFragmentShader)
@@ -781,10 +1018,62 @@ void MainWindow::promptSaveCurrentFragmentShaderScreenshot()
 }
 
 
+//------------------------------------------------------------------------
+// MainWindow::promptExportCurrentFragmentShaderFrames
+//------------------------------------------------------------------------
+void MainWindow::promptExportCurrentFragmentShaderFrames()
+{
+  if(!fCurrentFragmentShader)
+    return;
+
+  newDialog("Export Frames", fCurrentFragmentShader->getName())
+    .content([this] (auto &iDialog) {
+      ImGui::SeparatorText("Filename");
+      auto label = fmt::printf("-#####.%s###name", fScreenshotFormat.fExtension);
+      iDialog.initKeyboardFocusHere();
+      ImGui::InputText(label.c_str(), &iDialog.state());
+      iDialog.button(0).fEnabled = !iDialog.state().empty();
+      ImGui::SeparatorText("Format");
+      if(ImGui::BeginCombo("Format", fScreenshotFormat.fDescription.c_str()))
+      {
+        for(auto &format: image::format::kAll)
+        {
+          if(ImGui::Selectable(format.fDescription.c_str(), fScreenshotFormat.fMimeType == format.fMimeType))
+            fScreenshotFormat = format;
+        }
+        ImGui::EndCombo();
+      }
+      if(fScreenshotFormat.fHasQuality)
+        ImGui::SliderInt("Quality", &fScreenshotQualityPercent, 1, 100, "%d%%");
+
+      ImGui::SeparatorText("Frames");
+      ImGui::InputInt("Frame Count", &fExportFrameCount);
+      fExportFrameCount = std::clamp(fExportFrameCount, 1, 100000);
+      ImGui::SliderInt("FPS", &fExportFPS, 1, 240);
+      auto size = fFragmentShaderWindow->getRenderSize();
+      ImGui::Text("%dx%d | %.2fs (time starts at 0)",
+                  size.width,
+                  size.height,
+                  static_cast<float>(fExportFrameCount) / static_cast<float>(fExportFPS));
+    })
+    .button("Export", [this] (auto &iDialog) {
+      fFragmentShaderWindow->exportFrames({
+        .fFrameCount = fExportFrameCount,
+        .fFPS = fExportFPS,
+        .fName = iDialog.state(),
+        .fExtension = fScreenshotFormat.fExtension,
+        .fMimeType = fScreenshotFormat.fMimeType,
+        .fQuality = static_cast<float>(fScreenshotQualityPercent) / 100.0f
+      });
+    }, true)
+    .allowDismissDialog()
+    .buttonCancel();
+}
+
 //------------------------------------------------------------------------
 // MainWindow::renderShaderMenu
 //------------------------------------------------------------------------
-void MainWindow::renderShaderMenu(TextEditor &iEditor, std::string const &iNewCode, bool iEdited)
+void MainWindow::renderShaderMenu(TextEditor &iEditor, bool iEdited)
 {
   if(ImGui::BeginMenu("Shader"))
   {
@@ -792,13 +1081,13 @@ void MainWindow::renderShaderMenu(TextEditor &iEditor, std::string const &iNewCo
     ImGui::SeparatorText("Shader");
 
     if(ImGui::MenuItem(ICON_FA_Hammer " Compile", getShortcutString("D"), false, iEdited))
-      compile(iNewCode);
+      compile(iEditor.GetText());
     if(ImGui::MenuItem("Rename"))
       promptRenameCurrentShader();
     if(ImGui::MenuItem("Duplicate"))
       promptDuplicateShader(fCurrentFragmentShader->getName());
     if(ImGui::MenuItem("Export"))
-      promptExportShader(fCurrentFragmentShader->getName(), iNewCode);
+      promptExportShader(fCurrentFragmentShader->getName(), iEditor.GetText());
 
     // -- Edit ------
     ImGui::SeparatorText("Edit");
@@ -820,6 +1109,16 @@ void MainWindow::renderShaderMenu(TextEditor &iEditor, std::string const &iNewCo
       promptShaderFrameSize();
     if(ImGui::MenuItem(ICON_FA_Camera " Screenshot"))
       promptSaveCurrentFragmentShaderScreenshot();
+    if(fFragmentShaderWindow->isFramesExportInProgress())
+    {
+      if(ImGui::MenuItem("Cancel Export Frames"))
+        fFragmentShaderWindow->cancelFramesExport();
+    }
+    else
+    {
+      if(ImGui::MenuItem("Export Frames"))
+        promptExportCurrentFragmentShaderFrames();
+    }
 
     ImGui::EndMenu();
   }
@@ -840,18 +1139,25 @@ void MainWindow::renderShaderSection(bool iEditorHasFocus)
     editor.SetLineSpacing(fLineSpacing);
     editor.SetShowWhitespacesEnabled(fCodeShowWhiteSpace);
 
-    auto newCode = editor.GetText();
-    auto edited = newCode != fCurrentFragmentShader->getCode();
+    auto now = glfwGetTime();
+    fCurrentFragmentShader->checkForEdits(now);
+    auto edited = fCurrentFragmentShader->isEdited();
 
     // [Keyboard shortcut]
     if(iEditorHasFocus && ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_D))
     {
       if(edited)
-        compile(newCode);
+        compile(editor.GetText());
+    }
+    // [Live compile] compiles once typing has paused (only one compilation in flight per shader)
+    else if(fCodeLiveCompile && edited && !fCurrentFragmentShader->isCompilationInProgress())
+    {
+      if(now - fCurrentFragmentShader->getLastEditTime() >= fCodeLiveCompileDelay)
+        compile(editor.GetText());
     }
     if(ImGui::BeginMainMenuBar())
     {
-      renderShaderMenu(editor, newCode, edited);
+      renderShaderMenu(editor, edited);
       ImGui::EndMainMenuBar();
     }
 
@@ -871,7 +1177,7 @@ void MainWindow::renderShaderSection(bool iEditorHasFocus)
           ImGui::Text("%d/%d | %d lines", lineCount + 1, columnCount + 1, editor.GetLineCount());
           ImGui::BeginDisabled(!edited);
           if(ImGui::Button(ICON_FA_Hammer " Compile"))
-            compile(newCode);
+            compile(editor.GetText());
           ImGui::EndDisabled();
           ImGui::EndMenuBar();
         }
@@ -916,19 +1222,82 @@ void MainWindow::renderShaderSection(bool iEditorHasFocus)
                   static_cast<int>(inputs.size.x), static_cast<int>(inputs.size.y), inputs.size.z, inputs.size.w, // size: vec4f
                   static_cast<int>(inputs.mouse.x), static_cast<int>(inputs.mouse.y), static_cast<int>(inputs.mouse.z), static_cast<int>(inputs.mouse.w), // mouse: vec4f
                   inputs.time, // time: f32
-                  inputs.frame // frame: i32
+                  inputs.frame, // frame: i32
+                  static_cast<int>(inputs.offset.x), static_cast<int>(inputs.offset.y) // offset: vec2f
       );
       ImGui::EndTabItem();
     }
+
+    // [TabItem] Overrides
+    if(ImGui::BeginTabItem("Overrides"))
+    {
+      renderOverrides();
+      ImGui::EndTabItem();
+    }
     ImGui::EndTabBar();
   }
 }
 
+//------------------------------------------------------------------------
+// MainWindow::renderOverrides
+//------------------------------------------------------------------------
+void MainWindow::renderOverrides()
+{
+  auto const &overrides = fCurrentFragmentShader->getOverrides();
+  if(overrides.empty())
+  {
+    ImGui::TextWrapped("Declare pipeline-overridable constants in the shader (ex: override speed: f32 = 1.0;) "
+                       "to tweak them here without recompiling.");
+    return;
+  }
+
+  if(ImGui::Button("Reset"))
+    fCurrentFragmentShader->resetOverrideValues();
+
+  for(auto const &o: overrides)
+  {
+    ImGui::PushID(o.fName.c_str());
+    auto value = fCurrentFragmentShader->getOverrideValue(o.fName);
+    auto label = fmt::printf("%s: %s", o.fName, o.fType);
+    if(!value && o.hasExpressionDefault())
+    {
+      // the value of the expression is unknown: it cannot be edited until explicitly overridden
+      if(ImGui::Button("Override"))
+        fCurrentFragmentShader->setOverrideValue(o.fName, 0.0);
+      ImGui::SameLine();
+      ImGui::TextDisabled("%s = %s (expression, not editable until overridden)", label.c_str(), o.fInitializer->c_str());
+    }
+    else if(o.isBool())
+    {
+      bool b = value.value_or(0.0) != 0.0;
+      if(ImGui::Checkbox(label.c_str(), &b))
+        fCurrentFragmentShader->setOverrideValue(o.fName, b ? 1.0 : 0.0);
+    }
+    else if(o.isInteger())
+    {
+      int i = static_cast<int>(value.value_or(0.0));
+      if(ImGui::DragInt(label.c_str(), &i))
+        fCurrentFragmentShader->setOverrideValue(o.fName, o.fType == "u32" ? std::max(i, 0) : i);
+    }
+    else
+    {
+      auto d = value.value_or(0.0);
+      if(ImGui::DragScalar(label.c_str(), ImGuiDataType_Double, &d, 0.01f))
+        fCurrentFragmentShader->setOverrideValue(o.fName, d);
+    }
+    if(o.hasExpressionDefault() && ImGui::IsItemHovered())
+      ImGui::SetTooltip("Default: %s", o.fInitializer->c_str());
+    ImGui::PopID();
+  }
+}
+
 //------------------------------------------------------------------------
 // MainWindow::renderDialog
 //------------------------------------------------------------------------
 void MainWindow::renderDialog()
 {
+  utils::trace::Span span{"renderDialog", "ui"};
+
   if(!fCurrentDialog)
   {
     if(fDialogs.empty())
@@ -974,6 +1343,9 @@ void MainWindow::renderExampleMenu()
 //------------------------------------------------------------------------
 void MainWindow::doRender()
 {
+  fImGuiFrameRendered = true;
+  fLastRenderedStatus = fCurrentFragmentShader ? fCurrentFragmentShader->getStatus() : nullptr;
+
   ImGui::PushFont(nullptr, fFontSize);
 
   fIconButtonSize = {ImGui::CalcTextSize(fa::kCameraPolaroid).x + 2 * ImGui::GetStyle().ItemInnerSpacing.x, 0};
@@ -1072,6 +1444,9 @@ void MainWindow::doRender()
   }
   ImGui::End();
 
+  if(fShowFrameTimings)
+    renderFrameTimings();
+
   ImGui::PopFont();
 
 #ifndef NDEBUG
@@ -1136,6 +1511,8 @@ void MainWindow::setCurrentFragmentShader(std::shared_ptr<FragmentShader> iFragm
 //------------------------------------------------------------------------
 void MainWindow::beforeFrame()
 {
+  fImGuiFrameRendered = false;
+
   auto actions = std::move(fBeforeImGuiFrameActions);
   for(auto &action: actions)
     action();
@@ -1147,7 +1524,30 @@ void MainWindow::beforeFrame()
 //    fFragmentShaderWindow->setAspectRatio(*fAspectRatioRequest);
 //    fAspectRatioRequest = std::nullopt;
 //  }
-  fFragmentShaderWindow->beforeFrame();
+  {
+    auto timing = fFragmentShaderWindow->getPhaseTimings().measure("beforeFrame");
+    fFragmentShaderWindow->beforeFrame();
+  }
+
+  if(auto error = fFragmentShaderWindow->consumeHiResScreenshotError())
+  {
+    newDialog("Error")
+      .content([error = *error]{
+        ImGui::Text("There was an error while saving the screenshot");
+        ImGui::TextUnformatted(error.c_str());
+      })
+      .buttonOk();
+  }
+
+  if(auto error = fFragmentShaderWindow->consumeFramesExportError())
+  {
+    newDialog("Error")
+      .content([error = *error]{
+        ImGui::Text("There was an error while exporting the frames");
+        ImGui::TextUnformatted(error.c_str());
+      })
+      .buttonOk();
+  }
 }
 
 //------------------------------------------------------------------------
@@ -1156,34 +1556,128 @@ void MainWindow::beforeFrame()
 void MainWindow::afterFrame()
 {
   Renderable::afterFrame();
+  {
+    auto timing = fFragmentShaderWindow->getPhaseTimings().measure("afterFrame");
+    fFragmentShaderWindow->afterFrame();
+  }
+
   auto time = glfwGetTime();
   // check every 10s
   if(fBrowserAutoSave && fLastComputedStateTime + 10.0 < time)
   {
+    auto timing = getPhaseTimings().measure("autosave");
 //    printf("Checking... [%f], [%f]\n", fLastComputedStateTime, time);
-    auto state = computeState();
-    auto serializedState = Preferences::serialize(state);
+    State state{};
+    {
+      utils::trace::Span span{"computeState", "autosave"};
+      state = computeState();
+    }
+    std::string serializedState{};
+    {
+      utils::trace::Span span{"Preferences::serialize", "autosave"};
+      serializedState = Preferences::serialize(state);
+    }
     if(serializedState != fLastComputedState)
     {
 //      printf("Different... \n[%s] \n!=\n [%s]\n", fLastComputedState.c_str(), serializedState.c_str());
+      utils::trace::Span span{"Preferences::storeState", "autosave"};
       fLastComputedState = serializedState;
       fPreferences->storeState(Preferences::kStateKey, state);
     }
     fLastComputedStateTime = time;
   }
 
-  // Quick Export
-  if(ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_S))
+  // Quick Export (the key state is only valid when an ImGui frame was actually rendered)
+  if(fImGuiFrameRendered && ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_S))
     exportProject();
 }
 
+//------------------------------------------------------------------------
+// MainWindow::setRenderOnDemand
+//------------------------------------------------------------------------
+void MainWindow::setRenderOnDemand(bool iRenderOnDemand)
+{
+  ImGuiWindow::setRenderOnDemand(iRenderOnDemand);
+  fFragmentShaderWindow->setRenderOnDemand(iRenderOnDemand);
+}
+
+//------------------------------------------------------------------------
+// MainWindow::setPresentMode
+//------------------------------------------------------------------------
+void MainWindow::setPresentMode(wgpu::PresentMode iPresentMode)
+{
+  ImGuiWindow::setPresentMode(iPresentMode);
+  fFragmentShaderWindow->setPresentMode(iPresentMode);
+}
+
+//------------------------------------------------------------------------
+// MainWindow::setOpaque
+//------------------------------------------------------------------------
+void MainWindow::setOpaque(bool iOpaque)
+{
+  ImGuiWindow::setOpaque(iOpaque);
+  fFragmentShaderWindow->setOpaque(iOpaque);
+}
+
+//------------------------------------------------------------------------
+// MainWindow::needsRender
+//------------------------------------------------------------------------
+bool MainWindow::needsRender() const
+{
+  return ImGuiWindow::needsRender() || fFragmentShaderWindow->needsRender();
+}
+
+//------------------------------------------------------------------------
+// MainWindow::isDirty
+//------------------------------------------------------------------------
+bool MainWindow::isDirty() const
+{
+  // dialogs may be opened from outside the frame loop (ex: import)
+  if(hasDialog())
+    return true;
+
+  // the timings are displayed
+  if(fShowFrameTimings)
+    return true;
+
+  // the progress of the screenshot/export is displayed
+  if(fFragmentShaderWindow->isHiResScreenshotInProgress() || fFragmentShaderWindow->isFramesExportInProgress())
+    return true;
+
+  if(fCurrentFragmentShader)
+  {
+    // compilation status changes
+    if(fCurrentFragmentShader->getStatus() != fLastRenderedStatus)
+      return true;
+
+    // [Live compile] a compilation is pending (the delay is checked while rendering the code)
+    if(fCodeLiveCompile && fCurrentFragmentShader->isEdited() && !fCurrentFragmentShader->isCompilationInProgress())
+      return true;
+
+    // the inputs (time, frame) and fps are displayed
+    if(fCurrentFragmentShader->isEnabled() && fCurrentFragmentShader->isRunning() && fCurrentFragmentShader->hasRenderPipeline())
+      return true;
+  }
+
+  return false;
+}
+
 //------------------------------------------------------------------------
 // MainWindow::render
 //------------------------------------------------------------------------
 void MainWindow::render()
 {
-  Renderable::render();
-  fFragmentShaderWindow->render();
+  // each window is only rendered when needed (always, unless rendering on demand)
+  if(ImGuiWindow::needsRender())
+  {
+    auto timing = getPhaseTimings().measure("ImGui");
+    Renderable::render();
+  }
+  if(fFragmentShaderWindow->needsRender())
+  {
+    auto timing = fFragmentShaderWindow->getPhaseTimings().measure("render");
+    fFragmentShaderWindow->render();
+  }
 }
 
 //------------------------------------------------------------------------
@@ -1218,10 +1712,27 @@ State::Settings MainWindow::computeStateSettings() const
     .fFontSize = fFontSize,
     .fLineSpacing = fLineSpacing,
     .fCodeShowWhiteSpace = fCodeShowWhiteSpace,
+    .fCodeLiveCompile = fCodeLiveCompile,
+    .fCodeLiveCompileDelay = fCodeLiveCompileDelay,
+    .fCodeWarmUpFrameBudgetMs = fCodeWarmUpFrameBudgetMs,
+    .fCodeMaxInFlightCompilations = fFragmentShaderWindow->getMaxInFlightCompilations(),
     .fScreenshotMimeType = fScreenshotFormat.fMimeType,
     .fScreenshotQualityPercent = fScreenshotQualityPercent,
+    .fScreenshotScale = fScreenshotScale,
+    .fExportFrameCount = fExportFrameCount,
+    .fExportFPS = fExportFPS,
     .fProjectFilename = fProjectFilename,
     .fBrowserAutoSave = fBrowserAutoSave,
+    .fRenderOnDemand = isRenderOnDemand(),
+    .fAdaptiveResolution = fFragmentShaderWindow->isAdaptiveResolution(),
+    .fAdaptiveResolutionTargetFPS = fAdaptiveResolutionTargetFPS,
+    .fProgressiveRendering = fFragmentShaderWindow->isProgressiveRendering(),
+    .fUIFrameInterval = getCadence().fFrameInterval,
+    .fUIMaxFPS = getCadence().fMaxFPS,
+    .fShaderFrameInterval = fFragmentShaderWindow->getCadence().fFrameInterval,
+    .fShaderMaxFPS = fFragmentShaderWindow->getCadence().fMaxFPS,
+    .fPresentMode = presentModeAsString(fFragmentShaderWindow->getPresentMode()),
+    .fOpaque = fFragmentShaderWindow->isOpaque(),
   };
 }
 
@@ -1242,7 +1753,8 @@ State::Shaders MainWindow::computeStateShaders() const
       .fName = shader->getName(),
       .fCode = shader->getCode(),
       .fEditedCode = shader->getEditedCode(),
-      .fWindowSize = shader->getWindowSize()}
+      .fWindowSize = shader->getWindowSize(),
+      .fOverrideValues = shader->getOverrideValues()}
     );
   }
 
@@ -1335,6 +1847,8 @@ int MainWindow::onFile(char const *iName)
   if(!iName)
     return 0;
 
+  requestRender();
+
   return newContentRequest({NewContentRequest::File{iName}});
 }
 
@@ -1351,6 +1865,9 @@ void MainWindow::onNewContent(int iToken, char const *iName, char const *iConten
     return;
 
   auto request = std::exchange(fNewContentRequest, std::nullopt);
+  requestRender();
+
+  utils::trace::Tracer::instance().endAsync(request->fTraceId, "Import", "io", iError ? "error" : iName);
 
   if(iError)
   {
@@ -1374,6 +1891,8 @@ void MainWindow::onNewContent(int iToken, char const *iName, char const *iConten
 //------------------------------------------------------------------------
 void MainWindow::onNewFile(char const *iName, char const *iContent)
 {
+  utils::trace::Span span{"MainWindow::onNewFile", "io", iName};
+
   std::string name = iName;
   if(impl::ends_with(name, ".json"))
     loadFromState(name, Preferences::deserialize(iContent, State{.fSettings = computeStateSettings()}));
@@ -1572,6 +2091,46 @@ bool RenderUndoAction(pongasoft::utils::Action const *iAction, bool iSelected)
 
 }
 
+//------------------------------------------------------------------------
+// MainWindow::renderFrameTimings
+//------------------------------------------------------------------------
+void MainWindow::renderFrameTimings()
+{
+  ImGui::SetNextWindowBgAlpha(0.85f);
+  if(ImGui::Begin("Frame Timings", &fShowFrameTimings, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoCollapse))
+  {
+    ImGui::Text("CPU time of each phase over the last %zu frames", utils::TimingHistory::kDefaultCapacity);
+    if(fMainLoopTimings)
+      impl::renderPhaseTimings("Main Loop", *fMainLoopTimings);
+    impl::renderPhaseTimings("Main Window", getPhaseTimings());
+    impl::renderPhaseTimings("Shader Window (included in Main Window)", fFragmentShaderWindow->getPhaseTimings());
+  }
+  ImGui::End();
+}
+
+//------------------------------------------------------------------------
+// MainWindow::renderTraceMenu
+//------------------------------------------------------------------------
+void MainWindow::renderTraceMenu()
+{
+  auto &tracer = utils::trace::Tracer::instance();
+  if(ImGui::BeginMenu("Trace"))
+  {
+    if(ImGui::MenuItem("Record", nullptr, tracer.isEnabled()))
+      tracer.setEnabled(!tracer.isEnabled());
+    ImGui::BeginDisabled(tracer.getEventCount() == 0);
+    // can be loaded in Perfetto (https://ui.perfetto.dev) or chrome://tracing
+    if(ImGui::MenuItem("Export"))
+      wgpu_shader_toy_export_content("WebGPUShaderToy-trace.json", tracer.exportChromeTrace().c_str());
+    if(ImGui::MenuItem("Clear"))
+      tracer.clear();
+    ImGui::EndDisabled();
+    ImGui::Separator();
+    ImGui::TextDisabled("%zu/%zu events", tracer.getEventCount(), utils::trace::Tracer::kDefaultCapacity);
+    ImGui::EndMenu();
+  }
+}
+
 //------------------------------------------------------------------------
 // MainWindow::renderHistory
 //------------------------------------------------------------------------
@@ -1684,6 +2243,9 @@ void MainWindow::onURLImported(std::string const &iURL, char const *iName, char
 int MainWindow::newContentRequest(MainWindow::NewContentRequest::Source iSource)
 {
   fNewContentRequest = NewContentRequest{std::move(iSource)};
+  fNewContentRequest->fTraceId = utils::trace::Tracer::instance().beginAsync("Import",
+                                                                             "io",
+                                                                             fNewContentRequest->getValue());
   newDialog("Loading Shader...")
     .content([this, token = fNewContentRequest->fToken, progress = 0.0f] (auto &iDialog) mutable {
       if(!fNewContentRequest || fNewContentRequest->fToken != token)
@@ -1697,7 +2259,11 @@ int MainWindow::newContentRequest(MainWindow::NewContentRequest::Source iSource)
         ImGui::ProgressBar(progress, ImVec2(-FLT_MIN, 0), "");
       }
     })
-    .button("Cancel", [this] { fNewContentRequest = std::nullopt; });
+    .button("Cancel", [this] {
+      if(fNewContentRequest)
+        utils::trace::Tracer::instance().endAsync(fNewContentRequest->fTraceId, "Import", "io", "cancelled");
+      fNewContentRequest = std::nullopt;
+    });
   return fNewContentRequest->fToken;
 }
 
@@ -24,6 +24,7 @@
 #include "Preferences.h"
 #include "FragmentShaderWindow.h"
 #include "utils/UndoManager.h"
+#include "utils/Trace.h"
 #include <optional>
 #include <string>
 #include <map>
@@ -83,6 +84,7 @@ public:
     State defaultState;
     State state;
     std::shared_ptr<Preferences> preferences;
+    std::shared_ptr<utils::PhaseTimings> mainLoopTimings{};
   };
 
 public:
@@ -95,6 +97,11 @@ public:
 
   void afterFrame() override;
 
+  void setRenderOnDemand(bool iRenderOnDemand) override;
+  bool needsRender() const override;
+  void setPresentMode(wgpu::PresentMode iPresentMode) override;
+  void setOpaque(bool iOpaque) override;
+
   int onFile(char const *iName);
   void onNewContent(int iToken, char const *iName, char const *iContent, char const *iError);
   void maybeNewFragmentShader(std::string const &iTitle, std::string const &iOkButton, Shader const &iShader);
@@ -113,6 +120,7 @@ public:
 
 protected:
   void doRender() override;
+  bool isDirty() const override;
 
 private:
   using gui_action_t = std::function<void()>;
@@ -131,6 +139,8 @@ private:
 
     int fToken;
     Source fSource;
+    // [Trace] from the request to the content (or error)
+    utils::trace::id_t fTraceId{};
   };
 
 private:
@@ -154,6 +164,9 @@ private:
   void onURLImported(std::string const &iURL, char const *iName, char const *iContent);
   void setStyle(bool iDarkStyle);
   void setFontSize(float iFontSize);
+  void setWarmUpFrameBudget(float iBudgetMs);
+  void setAdaptiveResolutionTargetFPS(int iTargetFPS);
+  void warmUpFragmentShaders();
   void loadFont();
   void setManualLayout(bool iManualLayout, std::optional<Size> iLeftPaneSize = std::nullopt, std::optional<Size> iRightPaneSize = std::nullopt);
   void switchToManualLayout();
@@ -162,12 +175,15 @@ private:
   void setWindowOrder();
   void renderDialog();
   void renderMainMenuBar();
-  void renderShaderMenu(TextEditor &iEditor, std::string const &iNewCode, bool iEdited);
+  void renderShaderMenu(TextEditor &iEditor, bool iEdited);
   void renderSettingsMenu();
   void renderControlsSection();
   void renderTimeControls();
   void renderShaderSection(bool iEditorHasFocus);
+  void renderOverrides();
   void renderHistory();
+  void renderFrameTimings();
+  void renderTraceMenu();
   void renderExampleMenu();
   void compile(std::string const &iNewCode);
   void promptNewEmtpyShader();
@@ -185,6 +201,8 @@ private:
   void promptShaderFrameSize();
   void promptSaveCurrentFragmentShaderScreenshot();
   void saveCurrentFragmentShaderScreenshot(std::string const &iFilename);
+  gpu::Renderable::Size computeScreenshotSize() const;
+  void promptExportCurrentFragmentShaderFrames();
   void renameShader(std::string const &iOldName, std::string const &iNewName);
   void resizeShader(Renderable::Size const &iSize, bool iApplyToAll);
   int newContentRequest(NewContentRequest::Source iSource);
@@ -197,12 +215,13 @@ private:
   gui::DialogNoState &newDialog(std::string iTitle);
   char const *getShortcutString(char const *iKey, char const *iFormat = "%s + %s");
 
-  void deferBeforeImGuiFrame(gui_action_t iAction) { if(iAction) fBeforeImGuiFrameActions.emplace_back(std::move(iAction)); }
+  void deferBeforeImGuiFrame(gui_action_t iAction) { if(iAction) { fBeforeImGuiFrameActions.emplace_back(std::move(iAction)); requestRender(); } }
 
   std::shared_ptr<FragmentShader> findFragmentShaderByName(std::string const &iName) const;
 
 private:
   std::shared_ptr<Preferences> fPreferences;
+  std::shared_ptr<utils::PhaseTimings> fMainLoopTimings;
   State fDefaultState;
   std::string fLastComputedState;
   double fLastComputedStateTime;
@@ -212,10 +231,20 @@ private:
   float fLineSpacing{1.0f};
   float fFontSize{};
   bool fCodeShowWhiteSpace{false};
+  bool fCodeLiveCompile{false};
+  float fCodeLiveCompileDelay{0.5f};
+  float fCodeWarmUpFrameBudgetMs{2.0f};
   image::format::Format fScreenshotFormat{image::format::kPNG};
   int fScreenshotQualityPercent{85};
+  int fScreenshotScale{1};
+  int fExportFrameCount{60};
+  int fExportFPS{60};
   std::string fProjectFilename{"WebGPUShaderToy.json"};
   bool fBrowserAutoSave{true};
+  bool fImGuiFrameRendered{false};
+  bool fShowFrameTimings{false};
+  int fAdaptiveResolutionTargetFPS{30};
+  char const *fLastRenderedStatus{};
 
   std::shared_ptr<FragmentShaderWindow> fFragmentShaderWindow;
 
@@ -285,10 +285,25 @@ void MainWindow::initFromStateAction(State::Settings const &iSettings)
     fFragmentShaderWindow->toggleHiDPIAwareness();
   fLineSpacing = iSettings.fLineSpacing;
   fCodeShowWhiteSpace = iSettings.fCodeShowWhiteSpace;
+  fCodeLiveCompile = iSettings.fCodeLiveCompile;
+  fCodeLiveCompileDelay = iSettings.fCodeLiveCompileDelay;
+  setWarmUpFrameBudget(iSettings.fCodeWarmUpFrameBudgetMs);
+  fFragmentShaderWindow->setMaxInFlightCompilations(iSettings.fCodeMaxInFlightCompilations);
   fScreenshotFormat = image::format::getFormatFromMimeType(iSettings.fScreenshotMimeType);
   fScreenshotQualityPercent = iSettings.fScreenshotQualityPercent;
+  fScreenshotScale = iSettings.fScreenshotScale;
+  fExportFrameCount = iSettings.fExportFrameCount;
+  fExportFPS = iSettings.fExportFPS;
   fProjectFilename = iSettings.fProjectFilename;
   fBrowserAutoSave = iSettings.fBrowserAutoSave;
+  setRenderOnDemand(iSettings.fRenderOnDemand);
+  fFragmentShaderWindow->setAdaptiveResolution(iSettings.fAdaptiveResolution);
+  setAdaptiveResolutionTargetFPS(iSettings.fAdaptiveResolutionTargetFPS);
+  fFragmentShaderWindow->setProgressiveRendering(iSettings.fProgressiveRendering);
+  setCadence({.fFrameInterval = iSettings.fUIFrameInterval, .fMaxFPS = iSettings.fUIMaxFPS});
+  fFragmentShaderWindow->setCadence({.fFrameInterval = iSettings.fShaderFrameInterval, .fMaxFPS = iSettings.fShaderMaxFPS});
+  setPresentMode(presentModeFromString(iSettings.fPresentMode).value_or(wgpu::PresentMode::Fifo));
+  setOpaque(iSettings.fOpaque);
 }
 
 //------------------------------------------------------------------------
@@ -322,6 +337,8 @@ void MainWindow::initFromStateAction(State::Shaders const &iShaders)
     else
       setCurrentFragmentShader(fFragmentShaders[0]);
   }
+
+  warmUpFragmentShaders();
 }
 
 //------------------------------------------------------------------------
@@ -25,7 +25,7 @@ namespace shader_toy {
 
 namespace impl {
 
-gpu::Renderable::Size value(json const &iObject, std::string const &iKey, gpu::Renderable::Size const &iDefaultValue)
+gpu::Size value(json const &iObject, std::string const &iKey, gpu::Size const &iDefaultValue)
 {
   auto res = iDefaultValue;
   auto i = iObject.find(iKey);
@@ -75,6 +75,8 @@ std::string Preferences::serialize(State const &iState)
     };
     if(shader.fEditedCode)
       s["fEditedCode"] = shader.fEditedCode.value();
+    if(!shader.fOverrideValues.empty())
+      s["fOverrideValues"] = shader.fOverrideValues;
     shaders.emplace_back(s);
   }
 
@@ -92,10 +94,27 @@ std::string Preferences::serialize(State const &iState)
     {"fFontSize", settings.fFontSize},
     {"fLineSpacing", settings.fLineSpacing},
     {"fCodeShowWhiteSpace", settings.fCodeShowWhiteSpace},
+    {"fCodeLiveCompile", settings.fCodeLiveCompile},
+    {"fCodeLiveCompileDelay", settings.fCodeLiveCompileDelay},
+    {"fCodeWarmUpFrameBudgetMs", settings.fCodeWarmUpFrameBudgetMs},
+    {"fCodeMaxInFlightCompilations", settings.fCodeMaxInFlightCompilations},
     {"fScreenshotMimeType", settings.fScreenshotMimeType},
     {"fScreenshotQualityPercent", settings.fScreenshotQualityPercent},
+    {"fScreenshotScale", settings.fScreenshotScale},
+    {"fExportFrameCount", settings.fExportFrameCount},
+    {"fExportFPS", settings.fExportFPS},
     {"fProjectFilename", settings.fProjectFilename},
     {"fBrowserAutoSave", settings.fBrowserAutoSave},
+    {"fRenderOnDemand", settings.fRenderOnDemand},
+    {"fAdaptiveResolution", settings.fAdaptiveResolution},
+    {"fAdaptiveResolutionTargetFPS", settings.fAdaptiveResolutionTargetFPS},
+    {"fProgressiveRendering", settings.fProgressiveRendering},
+    {"fUIFrameInterval", settings.fUIFrameInterval},
+    {"fUIMaxFPS", settings.fUIMaxFPS},
+    {"fShaderFrameInterval", settings.fShaderFrameInterval},
+    {"fShaderMaxFPS", settings.fShaderMaxFPS},
+    {"fPresentMode", settings.fPresentMode},
+    {"fOpaque", settings.fOpaque},
     {"fShaders", shaders}
   };
 
@@ -125,10 +144,27 @@ State Preferences::deserialize(std::string const &iState, State const &iDefaultS
       settings.fFontSize = data.value("fFontSize", settings.fFontSize);
       settings.fLineSpacing = data.value("fLineSpacing", settings.fLineSpacing);
       settings.fCodeShowWhiteSpace = data.value("fCodeShowWhiteSpace", settings.fCodeShowWhiteSpace);
+      settings.fCodeLiveCompile = data.value("fCodeLiveCompile", settings.fCodeLiveCompile);
+      settings.fCodeLiveCompileDelay = data.value("fCodeLiveCompileDelay", settings.fCodeLiveCompileDelay);
+      settings.fCodeWarmUpFrameBudgetMs = data.value("fCodeWarmUpFrameBudgetMs", settings.fCodeWarmUpFrameBudgetMs);
+      settings.fCodeMaxInFlightCompilations = data.value("fCodeMaxInFlightCompilations", settings.fCodeMaxInFlightCompilations);
       settings.fScreenshotMimeType = data.value("fScreenshotMimeType", settings.fScreenshotMimeType);
       settings.fScreenshotQualityPercent = data.value("fScreenshotQualityPercent", settings.fScreenshotQualityPercent);
+      settings.fScreenshotScale = data.value("fScreenshotScale", settings.fScreenshotScale);
+      settings.fExportFrameCount = data.value("fExportFrameCount", settings.fExportFrameCount);
+      settings.fExportFPS = data.value("fExportFPS", settings.fExportFPS);
       settings.fProjectFilename = data.value("fProjectFilename", settings.fProjectFilename);
       settings.fBrowserAutoSave = data.value("fBrowserAutoSave", settings.fBrowserAutoSave);
+      settings.fRenderOnDemand = data.value("fRenderOnDemand", settings.fRenderOnDemand);
+      settings.fAdaptiveResolution = data.value("fAdaptiveResolution", settings.fAdaptiveResolution);
+      settings.fAdaptiveResolutionTargetFPS = data.value("fAdaptiveResolutionTargetFPS", settings.fAdaptiveResolutionTargetFPS);
+      settings.fProgressiveRendering = data.value("fProgressiveRendering", settings.fProgressiveRendering);
+      settings.fUIFrameInterval = data.value("fUIFrameInterval", settings.fUIFrameInterval);
+      settings.fUIMaxFPS = data.value("fUIMaxFPS", settings.fUIMaxFPS);
+      settings.fShaderFrameInterval = data.value("fShaderFrameInterval", settings.fShaderFrameInterval);
+      settings.fShaderMaxFPS = data.value("fShaderMaxFPS", settings.fShaderMaxFPS);
+      settings.fPresentMode = data.value("fPresentMode", settings.fPresentMode);
+      settings.fOpaque = data.value("fOpaque", settings.fOpaque);
       settings.fMainWindowSize = impl::value(data, "fMainWindowSize", settings.fMainWindowSize);
       settings.fFragmentShaderWindowSize = impl::value(data, "fFragmentShaderWindowSize", settings.fFragmentShaderWindowSize);
       if(data.find("fShaders") != data.end())
@@ -147,6 +183,8 @@ State Preferences::deserialize(std::string const &iState, State const &iDefaultS
               if(shader.contains("fEditedCode"))
                 s.fEditedCode = shader.at("fEditedCode");
               s.fWindowSize = impl::value(shader, "fWindowSize", state.fSettings.fFragmentShaderWindowSize);
+              if(shader.contains("fOverrideValues"))
+                s.fOverrideValues = shader.at("fOverrideValues");
               state.fShaders.fList.emplace_back(s);
             }
           }
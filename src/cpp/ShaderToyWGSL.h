@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#ifndef WGPU_SHADER_TOY_SHADER_TOY_WGSL_H
+#define WGPU_SHADER_TOY_SHADER_TOY_WGSL_H
+
+namespace shader_toy {
+
+// Prepended to the code of every fragment shader (must match FragmentShader::ShaderToyInputs)
+constexpr char kShaderToyHeader[] = R"(// Begin ShaderToy Header
+struct ShaderToyInputs {
+  size:  vec4f,
+  mouse: vec4f,
+  time:  f32,
+  frame: i32,
+  offset: vec2f,
+};
+
+@group(0) @binding(0) var<uniform> inputs: ShaderToyInputs;
+// End ShaderToy Header
+
+)";
+
+// 2 triangles covering the whole surface
+constexpr char kShaderToyVertexShader[] = R"(
+@vertex
+fn vertexMain(@builtin(vertex_index) i : u32) -> @builtin(position) vec4f {
+    const pos = array(vec2f(-1, 1), vec2f(-1, -1), vec2f(1, -1), vec2f(-1, 1), vec2f(1, -1), vec2f(1, 1));
+    return vec4f(pos[i], 0, 1);
+}
+)";
+
+}
+
+#endif //WGPU_SHADER_TOY_SHADER_TOY_WGSL_H
@@ -19,11 +19,11 @@
 #ifndef WGPU_SHADER_TOY_STATE_H
 #define WGPU_SHADER_TOY_STATE_H
 
-#include "gpu/Renderable.h"
+#include "gpu/Size.h"
+#include <map>
 #include <string>
 #include <vector>
 #include <optional>
-#include <imgui.h>
 
 namespace shader_toy {
 
@@ -31,18 +31,19 @@ using namespace pongasoft;
 
 struct Shader
 {
-  std::string fName;
-  std::string fCode;
-  std::optional<std::string> fEditedCode;
-  gpu::Renderable::Size fWindowSize;
+  std::string fName{};
+  std::string fCode{};
+  std::optional<std::string> fEditedCode{};
+  gpu::Size fWindowSize{};
+  std::map<std::string, double> fOverrideValues{}; // values of the overridden pipeline-overridable constants
 };
 
 struct State
 {
   struct Settings
   {
-    gpu::Renderable::Size fMainWindowSize{};
-    gpu::Renderable::Size fFragmentShaderWindowSize{};
+    gpu::Size fMainWindowSize{};
+    gpu::Size fFragmentShaderWindowSize{};
     bool fDarkStyle{true};
     bool fHiDPIAware{true};
     bool fLayoutManual{false};
@@ -50,10 +51,27 @@ struct State
     float fFontSize{13.0f};
     float fLineSpacing{1.0f};
     bool fCodeShowWhiteSpace{false};
+    bool fCodeLiveCompile{false};
+    float fCodeLiveCompileDelay{0.5f};
+    float fCodeWarmUpFrameBudgetMs{2.0f};
+    int fCodeMaxInFlightCompilations{4};
     std::string fScreenshotMimeType{"image/png"};
     int fScreenshotQualityPercent{85};
+    int fScreenshotScale{1};
+    int fExportFrameCount{60};
+    int fExportFPS{60};
     std::string fProjectFilename{"WebGPUShaderToy.json"};
     bool fBrowserAutoSave{true};
+    bool fRenderOnDemand{false};
+    bool fAdaptiveResolution{false};
+    int fAdaptiveResolutionTargetFPS{30};
+    bool fProgressiveRendering{false};
+    int fUIFrameInterval{1};
+    int fUIMaxFPS{0};
+    int fShaderFrameInterval{1};
+    int fShaderMaxFPS{0};
+    std::string fPresentMode{"Fifo"};
+    bool fOpaque{false};
   };
 
   struct Shaders
@@ -17,21 +17,27 @@
  */
 
 #include "GPU.h"
+#include "PassTimer.h"
 #include "../Errors.h"
 #include <utility>
+#include <chrono>
+#include <cstdio>
+#include <vector>
 
 namespace pongasoft::gpu {
 
 //------------------------------------------------------------------------
 // GPU::asyncCreate
 //------------------------------------------------------------------------
-void GPU::asyncCreate(std::function<void(std::shared_ptr<GPU> iGPU)> onCreated,
-                      std::function<void(wgpu::StringView)> onError)
+std::shared_ptr<GPU> GPU::asyncCreate(std::function<void(std::shared_ptr<GPU> iGPU)> onCreated,
+                                      std::function<void(wgpu::StringView)> onError,
+                                      bool iForceFallbackAdapter)
 {
   auto gpu = std::make_shared<GPU>(wgpu::CreateInstance());
   gpu->asyncInitDevice([gpu, onCreated = std::move(onCreated)] {
     onCreated(gpu);
-  }, std::move(onError));
+  }, std::move(onError), iForceFallbackAdapter);
+  return gpu;
 }
 
 //------------------------------------------------------------------------
@@ -46,11 +52,15 @@ GPU::GPU(wgpu::Instance iInstance) : fInstance{std::move(iInstance)}
 // GPU::asyncInitDevice
 //------------------------------------------------------------------------
 void GPU::asyncInitDevice(std::function<void()> const &onDeviceInitialized,
-                          std::function<void(wgpu::StringView)> const &onError)
+                          std::function<void(wgpu::StringView)> const &onError,
+                          bool iForceFallbackAdapter)
 {
-  wgpu::RequestAdapterWebXROptions xrOptions = {};
   wgpu::RequestAdapterOptions options = {};
+#ifdef __EMSCRIPTEN__
+  wgpu::RequestAdapterWebXROptions xrOptions = {};
   options.nextInChain = &xrOptions;
+#endif
+  options.forceFallbackAdapter = iForceFallbackAdapter;
 
   fInstance.RequestAdapter(&options, wgpu::CallbackMode::AllowSpontaneous,
                            [this, onDeviceInitialized, onError](wgpu::RequestAdapterStatus status,
@@ -66,6 +76,14 @@ void GPU::asyncInitDevice(std::function<void()> const &onDeviceInitialized,
                              wgpu::Limits limits;
                              wgpu::DeviceDescriptor deviceDescriptor;
                              deviceDescriptor.requiredLimits = &limits;
+
+                             // [GPU timing] optional: passes can be timed only when the device has this feature
+                             std::vector<wgpu::FeatureName> features{};
+                             if(fAdapter.HasFeature(wgpu::FeatureName::TimestampQuery))
+                               features.emplace_back(wgpu::FeatureName::TimestampQuery);
+                             deviceDescriptor.requiredFeatureCount = features.size();
+                             deviceDescriptor.requiredFeatures = features.data();
+
                              deviceDescriptor.SetUncapturedErrorCallback([](const wgpu::Device &, // unused
                                                                             const wgpu::ErrorType iErrorType,
                                                                             const wgpu::StringView iMessage,
@@ -92,6 +110,7 @@ void GPU::asyncInitDevice(std::function<void()> const &onDeviceInitialized,
                                                         return;
                                                       }
                                                       fDevice = std::move(dev);
+                                                      fObjectCache = std::make_unique<ObjectCache>(fDevice);
                                                       onDeviceInitialized();
                                                     });
                            });
@@ -114,6 +133,25 @@ void GPU::endFrame()
   wgpu::CommandBuffer commands = fCommandEncoder.Finish();
   fDevice.GetQueue().Submit(1, &commands);
   fCommandEncoder = nullptr;
+
+  // spontaneous so that the time is measured when the work is done (not when events are next processed)
+  fDevice.GetQueue().OnSubmittedWorkDone(wgpu::CallbackMode::AllowSpontaneous,
+                                         [this, submitTime = std::chrono::steady_clock::now()](wgpu::QueueWorkDoneStatus iStatus,
+                                                                                               auto const &) {
+                                           if(iStatus == wgpu::QueueWorkDoneStatus::Success)
+                                           {
+                                             std::chrono::duration<double> latency = std::chrono::steady_clock::now() - submitTime;
+                                             onFrameDone(latency.count());
+                                           }
+                                         });
+}
+
+//------------------------------------------------------------------------
+// GPU::onFrameDone
+//------------------------------------------------------------------------
+void GPU::onFrameDone(double iLatency)
+{
+  fFrameLatency = fFrameLatency == 0 ? iLatency : fFrameLatency * 0.9 + iLatency * 0.1;
 }
 
 //------------------------------------------------------------------------
@@ -129,7 +167,9 @@ void GPU::pollEvents()
 //------------------------------------------------------------------------
 void GPU::renderPass(wgpu::Color const &iColor,
                      render_pass_fn_t const &iRenderPassFn,
-                     wgpu::TextureView const &iTextureView)
+                     wgpu::TextureView const &iTextureView,
+                     wgpu::LoadOp iLoadOp,
+                     PassTimer *iPassTimer)
 {
   WST_INTERNAL_ASSERT(fCommandEncoder != nullptr, "GPU::beginFrame has not been called");
 
@@ -138,19 +178,25 @@ void GPU::renderPass(wgpu::Color const &iColor,
 
   wgpu::RenderPassColorAttachment attachment{
     .view = iTextureView,
-    .loadOp = wgpu::LoadOp::Clear,
+    .loadOp = iLoadOp,
     .storeOp = wgpu::StoreOp::Store,
     .clearValue = iColor
   };
 
+  auto timestampWrites = iPassTimer ? iPassTimer->beginPass() : nullptr;
+
   wgpu::RenderPassDescriptor renderpass{
     .colorAttachmentCount = 1,
     .colorAttachments = &attachment,
+    .timestampWrites = timestampWrites
   };
 
   wgpu::RenderPassEncoder pass = fCommandEncoder.BeginRenderPass(&renderpass);
   iRenderPassFn(pass);
   pass.End();
+
+  if(timestampWrites)
+    iPassTimer->endPass(fCommandEncoder);
 }
 
 //------------------------------------------------------------------------
@@ -24,11 +24,14 @@
 #include <functional>
 #include <optional>
 #include <string>
+#include "ObjectCache.h"
 
 struct GLFWwindow;
 
 namespace pongasoft::gpu {
 
+class PassTimer;
+
 class GPU
 {
 public:
@@ -43,23 +46,38 @@ public:
   using render_pass_fn_t = std::function<void(wgpu::RenderPassEncoder &)>;
 
   // Methods
-  static void asyncCreate(std::function<void(std::shared_ptr<GPU> iGPU)> onCreated,
-                          std::function<void(wgpu::StringView)> onError);
+  // The returned GPU is only usable once `onCreated` is called. Note that natively, events must be processed
+  // (`pollEvents`) until then. `iForceFallbackAdapter` requests a software adapter (headless/GPU-less machines).
+  static std::shared_ptr<GPU> asyncCreate(std::function<void(std::shared_ptr<GPU> iGPU)> onCreated,
+                                          std::function<void(wgpu::StringView)> onError,
+                                          bool iForceFallbackAdapter = false);
 
   wgpu::Instance getInstance() const { return fInstance; }
   wgpu::Adapter getAdapter() const { return fAdapter; }
   wgpu::Device getDevice() const { return fDevice; }
+  // shared (immutable) GPU objects: layouts, samplers, shader modules...
+  ObjectCache &getObjectCache() const { return *fObjectCache; }
 
   bool hasError() const { return fError.has_value(); }
   Error getError() const { return fError ? *fError : Error{}; }
   std::optional<Error> consumeError() { auto error = fError; fError = std::nullopt; return error; }
 
   void beginFrame();
-  void renderPass(wgpu::Color const &iColor, render_pass_fn_t const &iRenderPassFn, wgpu::TextureView const &iTextureView = nullptr);
+  // `iLoadOp` set to `wgpu::LoadOp::Load` preserves the content of the texture (`iColor` is then ignored)
+  // `iPassTimer` (optional) measures the time the GPU spends executing the pass
+  void renderPass(wgpu::Color const &iColor,
+                  render_pass_fn_t const &iRenderPassFn,
+                  wgpu::TextureView const &iTextureView = nullptr,
+                  wgpu::LoadOp iLoadOp = wgpu::LoadOp::Clear,
+                  PassTimer *iPassTimer = nullptr);
   void endFrame();
 
   void pollEvents();
 
+  // [Frame pacing] (smoothed) time between the submission of a frame and the GPU being done with it, in seconds.
+  // Note that the browser does not expose when the frame is actually presented.
+  constexpr double getFrameLatency() const { return fFrameLatency; }
+
   //------------------------------------------------------------------------
   // GPU::computeGamma
   //------------------------------------------------------------------------
@@ -124,15 +142,19 @@ public:
 private:
   // Methods
   void asyncInitDevice(std::function<void()> const &onDeviceInitialized,
-                       std::function<void(wgpu::StringView)> const &onError);
+                       std::function<void(wgpu::StringView)> const &onError,
+                       bool iForceFallbackAdapter);
+  void onFrameDone(double iLatency);
 
   // Members
   wgpu::Instance fInstance;
   wgpu::Adapter fAdapter{};
   wgpu::Device fDevice{};
   wgpu::CommandEncoder fCommandEncoder{};
+  std::unique_ptr<ObjectCache> fObjectCache{};
 
   std::optional<Error> fError{};
+  double fFrameLatency{};
 };
 
 }
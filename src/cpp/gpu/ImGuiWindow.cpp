@@ -20,6 +20,7 @@
 #include <backends/imgui_impl_glfw.h>
 #include <GLFW/emscripten_glfw3.h>
 #include "ImGuiWindow.h"
+#include <imgui_internal.h>
 
 namespace pongasoft::gpu {
 
@@ -62,16 +63,6 @@ ImGuiWindow::~ImGuiWindow()
   }
 }
 
-//------------------------------------------------------------------------
-// ImGuiWindow::doHandleFrameBufferSizeChange
-//------------------------------------------------------------------------
-void ImGuiWindow::doHandleFrameBufferSizeChange(Renderable::Size const &iSize)
-{
-  ImGui_ImplWGPU_InvalidateDeviceObjects();
-  Window::doHandleFrameBufferSizeChange(iSize);
-  ImGui_ImplWGPU_CreateDeviceObjects();
-}
-
 //------------------------------------------------------------------------
 // ImGuiWindow::doRender
 //------------------------------------------------------------------------
@@ -98,6 +89,9 @@ void ImGuiWindow::beforeFrame()
 {
   Window::beforeFrame();
   ImGui::SetCurrentContext(fImGuiContext);
+  // input events (mouse, keyboard...) received since the last frame are queued until the next ImGui frame
+  if(!fImGuiContext->InputEventsQueue.empty())
+    requestRender(kRenderFrameCountOnInput);
 }
 
 }
\ No newline at end of file
@@ -27,13 +27,15 @@ namespace pongasoft::gpu {
 
 class ImGuiWindow : public Window
 {
+public:
+  // number of frames rendered after an input event (ImGui needs a few frames to settle: hover, popups, layout...)
+  static constexpr int kRenderFrameCountOnInput = 3;
+
 public:
   ImGuiWindow(std::shared_ptr<GPU> iGPU, Args const &iArgs);
 
   ~ImGuiWindow() override;
 
-  void doHandleFrameBufferSizeChange(Size const &iSize) override;
-
   void beforeFrame() override;
 
 protected:
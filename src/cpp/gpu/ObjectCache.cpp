@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include "ObjectCache.h"
+#include <bit>
+#include <type_traits>
+
+namespace pongasoft::gpu {
+
+namespace impl {
+
+using utils::hash::hash_t;
+using utils::hash::combine;
+
+//------------------------------------------------------------------------
+// impl::combine (enum/flags)
+//------------------------------------------------------------------------
+template<typename E> requires std::is_enum_v<E>
+constexpr hash_t combine(hash_t iHash, E iValue)
+{
+  return utils::hash::combine(iHash, static_cast<std::uint64_t>(iValue));
+}
+
+//------------------------------------------------------------------------
+// impl::combineFloat
+//------------------------------------------------------------------------
+constexpr hash_t combineFloat(hash_t iHash, float iValue)
+{
+  return utils::hash::combine(iHash, std::bit_cast<std::uint32_t>(iValue));
+}
+
+//------------------------------------------------------------------------
+// impl::combine (object)
+// GPU objects are identified by their (unique) handle
+//------------------------------------------------------------------------
+template<typename T> requires requires (T const &t) { t.Get(); }
+hash_t combine(hash_t iHash, T const &iObject)
+{
+  return utils::hash::combine(iHash, reinterpret_cast<std::uintptr_t>(iObject.Get()));
+}
+
+}
+
+//------------------------------------------------------------------------
+// ObjectCache::findOrCreate
+//------------------------------------------------------------------------
+template<typename T, typename CreateFn>
+T ObjectCache::findOrCreate(std::unordered_map<utils::hash::hash_t, T> &iCache,
+                            utils::hash::hash_t iKey,
+                            CreateFn &&iCreateFn)
+{
+  if(auto iter = iCache.find(iKey); iter != iCache.end())
+  {
+    fHitCount++;
+    return iter->second;
+  }
+  fMissCount++;
+  auto object = iCreateFn();
+  iCache[iKey] = object;
+  return object;
+}
+
+//------------------------------------------------------------------------
+// ObjectCache::getBindGroupLayout
+//------------------------------------------------------------------------
+wgpu::BindGroupLayout ObjectCache::getBindGroupLayout(wgpu::BindGroupLayoutDescriptor const &iDescriptor)
+{
+  auto const create = [this, &iDescriptor] { return fDevice.CreateBindGroupLayout(&iDescriptor); };
+
+  if(iDescriptor.nextInChain)
+    return create();
+
+  auto key = impl::combine(utils::hash::kFNV1aOffsetBasis, iDescriptor.entryCount);
+  for(std::size_t i = 0; i < iDescriptor.entryCount; i++)
+  {
+    auto const &entry = iDescriptor.entries[i];
+    if(entry.nextInChain)
+      return create();
+    key = impl::combine(key, entry.binding);
+    key = impl::combine(key, entry.visibility);
+    key = impl::combine(key, entry.buffer.type);
+    key = impl::combine(key, static_cast<std::uint64_t>(entry.buffer.hasDynamicOffset));
+    key = impl::combine(key, entry.buffer.minBindingSize);
+    key = impl::combine(key, entry.sampler.type);
+    key = impl::combine(key, entry.texture.sampleType);
+    key = impl::combine(key, entry.texture.viewDimension);
+    key = impl::combine(key, static_cast<std::uint64_t>(entry.texture.multisampled));
+    key = impl::combine(key, entry.storageTexture.access);
+    key = impl::combine(key, entry.storageTexture.format);
+    key = impl::combine(key, entry.storageTexture.viewDimension);
+  }
+
+  return findOrCreate(fBindGroupLayouts, key, create);
+}
+
+//------------------------------------------------------------------------
+// ObjectCache::getPipelineLayout
+//------------------------------------------------------------------------
+wgpu::PipelineLayout ObjectCache::getPipelineLayout(wgpu::PipelineLayoutDescriptor const &iDescriptor)
+{
+  auto const create = [this, &iDescriptor] { return fDevice.CreatePipelineLayout(&iDescriptor); };
+
+  if(iDescriptor.nextInChain)
+    return create();
+
+  // bind group layouts are compared by handle, which is why it is important that they come from this cache too
+  auto key = impl::combine(utils::hash::kFNV1aOffsetBasis, iDescriptor.bindGroupLayoutCount);
+  for(std::size_t i = 0; i < iDescriptor.bindGroupLayoutCount; i++)
+    key = impl::combine(key, iDescriptor.bindGroupLayouts[i]);
+
+  return findOrCreate(fPipelineLayouts, key, create);
+}
+
+//------------------------------------------------------------------------
+// ObjectCache::getSampler
+//------------------------------------------------------------------------
+wgpu::Sampler ObjectCache::getSampler(wgpu::SamplerDescriptor const &iDescriptor)
+{
+  auto const create = [this, &iDescriptor] { return fDevice.CreateSampler(&iDescriptor); };
+
+  if(iDescriptor.nextInChain)
+    return create();
+
+  auto key = impl::combine(utils::hash::kFNV1aOffsetBasis, iDescriptor.addressModeU);
+  key = impl::combine(key, iDescriptor.addressModeV);
+  key = impl::combine(key, iDescriptor.addressModeW);
+  key = impl::combine(key, iDescriptor.magFilter);
+  key = impl::combine(key, iDescriptor.minFilter);
+  key = impl::combine(key, iDescriptor.mipmapFilter);
+  key = impl::combineFloat(key, iDescriptor.lodMinClamp);
+  key = impl::combineFloat(key, iDescriptor.lodMaxClamp);
+  key = impl::combine(key, iDescriptor.compare);
+  key = impl::combine(key, iDescriptor.maxAnisotropy);
+
+  return findOrCreate(fSamplers, key, create);
+}
+
+//------------------------------------------------------------------------
+// ObjectCache::getShaderModule
+//------------------------------------------------------------------------
+wgpu::ShaderModule ObjectCache::getShaderModule(std::string_view iWGSLCode, wgpu::StringView iLabel)
+{
+  return findOrCreate(fShaderModules, utils::hash::fnv1a(iWGSLCode), [this, iWGSLCode, iLabel] {
+    wgpu::ShaderSourceWGSL source{};
+    source.code = {iWGSLCode.data(), iWGSLCode.size()};
+    wgpu::ShaderModuleDescriptor descriptor{
+      .nextInChain = &source,
+      .label = iLabel
+    };
+    return fDevice.CreateShaderModule(&descriptor);
+  });
+}
+
+//------------------------------------------------------------------------
+// ObjectCache::getStats
+//------------------------------------------------------------------------
+ObjectCache::Stats ObjectCache::getStats() const
+{
+  return {
+    .fBindGroupLayoutCount = fBindGroupLayouts.size(),
+    .fPipelineLayoutCount = fPipelineLayouts.size(),
+    .fSamplerCount = fSamplers.size(),
+    .fShaderModuleCount = fShaderModules.size(),
+    .fHitCount = fHitCount,
+    .fMissCount = fMissCount
+  };
+}
+
+//------------------------------------------------------------------------
+// ObjectCache::clear
+//------------------------------------------------------------------------
+void ObjectCache::clear()
+{
+  fBindGroupLayouts.clear();
+  fPipelineLayouts.clear();
+  fSamplers.clear();
+  fShaderModules.clear();
+}
+
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#ifndef WGPU_SHADER_TOY_GPU_OBJECT_CACHE_H
+#define WGPU_SHADER_TOY_GPU_OBJECT_CACHE_H
+
+#include <webgpu/webgpu_cpp.h>
+#include <string_view>
+#include <unordered_map>
+#include "../utils/Hash.h"
+
+namespace pongasoft::gpu {
+
+/**
+ * Cache of immutable GPU objects (bind group layouts, pipeline layouts, samplers and shader modules) keyed by
+ * (a hash of) their descriptor, so that identical objects are created only once and shared by every window
+ * and shader. Labels are not part of the key (the label of the first object created is kept).
+ *
+ * Descriptors with a `nextInChain` (extensions) are not cached: a new object is created every time. */
+class ObjectCache
+{
+public:
+  struct Stats
+  {
+    std::size_t fBindGroupLayoutCount{};
+    std::size_t fPipelineLayoutCount{};
+    std::size_t fSamplerCount{};
+    std::size_t fShaderModuleCount{};
+    std::size_t fHitCount{};
+    std::size_t fMissCount{};
+
+    constexpr std::size_t getLiveObjectCount() const {
+      return fBindGroupLayoutCount + fPipelineLayoutCount + fSamplerCount + fShaderModuleCount;
+    }
+  };
+
+public:
+  explicit ObjectCache(wgpu::Device iDevice) : fDevice{std::move(iDevice)} {}
+
+  wgpu::BindGroupLayout getBindGroupLayout(wgpu::BindGroupLayoutDescriptor const &iDescriptor);
+  wgpu::PipelineLayout getPipelineLayout(wgpu::PipelineLayoutDescriptor const &iDescriptor);
+  wgpu::Sampler getSampler(wgpu::SamplerDescriptor const &iDescriptor);
+  wgpu::ShaderModule getShaderModule(std::string_view iWGSLCode, wgpu::StringView iLabel = {});
+
+  Stats getStats() const;
+  void clear();
+
+private:
+  template<typename T, typename CreateFn>
+  T findOrCreate(std::unordered_map<utils::hash::hash_t, T> &iCache, utils::hash::hash_t iKey, CreateFn &&iCreateFn);
+
+private:
+  wgpu::Device fDevice;
+
+  std::unordered_map<utils::hash::hash_t, wgpu::BindGroupLayout> fBindGroupLayouts{};
+  std::unordered_map<utils::hash::hash_t, wgpu::PipelineLayout> fPipelineLayouts{};
+  std::unordered_map<utils::hash::hash_t, wgpu::Sampler> fSamplers{};
+  std::unordered_map<utils::hash::hash_t, wgpu::ShaderModule> fShaderModules{};
+
+  std::size_t fHitCount{};
+  std::size_t fMissCount{};
+};
+
+}
+
+#endif //WGPU_SHADER_TOY_GPU_OBJECT_CACHE_H
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include "PassTimer.h"
+#include "../Errors.h"
+#include <utility>
+
+namespace pongasoft::gpu {
+
+namespace impl {
+
+// 2 timestamps (beginning and end of the pass) of 8 bytes each
+constexpr std::uint64_t kTimestampsSize = 2 * sizeof(std::uint64_t);
+
+}
+
+//------------------------------------------------------------------------
+// PassTimer::PassTimer
+//------------------------------------------------------------------------
+PassTimer::PassTimer(wgpu::Device iDevice) : fDevice{std::move(iDevice)}
+{
+  if(!fDevice.HasFeature(wgpu::FeatureName::TimestampQuery))
+    return;
+
+  wgpu::QuerySetDescriptor querySetDescriptor{
+    .label = "PassTimer | Query Set",
+    .type = wgpu::QueryType::Timestamp,
+    .count = 2
+  };
+  fQuerySet = fDevice.CreateQuerySet(&querySetDescriptor);
+
+  wgpu::BufferDescriptor resolveBufferDescriptor{
+    .label = "PassTimer | Resolve Buffer",
+    .usage = wgpu::BufferUsage::QueryResolve | wgpu::BufferUsage::CopySrc,
+    .size = impl::kTimestampsSize
+  };
+  fResolveBuffer = fDevice.CreateBuffer(&resolveBufferDescriptor);
+
+  wgpu::BufferDescriptor readbackBufferDescriptor{
+    .label = "PassTimer | Readback Buffer",
+    .usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead,
+    .size = impl::kTimestampsSize
+  };
+  for(std::size_t i = 0; i < kReadbackBufferCount; i++)
+    fReadbackBuffers.emplace_back(ReadbackBuffer{.fBuffer = fDevice.CreateBuffer(&readbackBufferDescriptor)});
+
+  fTimestampWrites = {
+    .querySet = fQuerySet,
+    .beginningOfPassWriteIndex = 0,
+    .endOfPassWriteIndex = 1
+  };
+}
+
+//------------------------------------------------------------------------
+// PassTimer::~PassTimer
+//------------------------------------------------------------------------
+PassTimer::~PassTimer()
+{
+  for(auto &buffer: fReadbackBuffers)
+    buffer.fBuffer.Destroy();
+  if(fResolveBuffer)
+    fResolveBuffer.Destroy();
+  if(fQuerySet)
+    fQuerySet.Destroy();
+}
+
+//------------------------------------------------------------------------
+// PassTimer::beginPass
+//------------------------------------------------------------------------
+wgpu::PassTimestampWrites const *PassTimer::beginPass()
+{
+  // a pass has already been measured in this frame
+  if(!isAvailable() || fEncodedIndex)
+    return nullptr;
+
+  for(std::size_t i = 0; i < fReadbackBuffers.size(); i++)
+  {
+    if(fReadbackBuffers[i].fState == ReadbackBufferState::kFree)
+    {
+      fEncodedIndex = i;
+      return &fTimestampWrites;
+    }
+  }
+
+  // all buffers are still being read back
+  return nullptr;
+}
+
+//------------------------------------------------------------------------
+// PassTimer::endPass
+//------------------------------------------------------------------------
+void PassTimer::endPass(wgpu::CommandEncoder const &iEncoder)
+{
+  WST_INTERNAL_ASSERT(fEncodedIndex.has_value(), "PassTimer::beginPass has not been called");
+
+  auto &readbackBuffer = fReadbackBuffers[*fEncodedIndex];
+  iEncoder.ResolveQuerySet(fQuerySet, 0, 2, fResolveBuffer, 0);
+  iEncoder.CopyBufferToBuffer(fResolveBuffer, 0, readbackBuffer.fBuffer, 0, impl::kTimestampsSize);
+  readbackBuffer.fState = ReadbackBufferState::kEncoded;
+}
+
+//------------------------------------------------------------------------
+// PassTimer::readback
+//------------------------------------------------------------------------
+void PassTimer::readback()
+{
+  if(!fEncodedIndex)
+    return;
+
+  auto const index = *std::exchange(fEncodedIndex, std::nullopt);
+  auto &readbackBuffer = fReadbackBuffers[index];
+
+  // beginPass was called but the pass was never encoded
+  if(readbackBuffer.fState != ReadbackBufferState::kEncoded)
+    return;
+
+  readbackBuffer.fState = ReadbackBufferState::kMapping;
+  readbackBuffer.fBuffer.MapAsync(wgpu::MapMode::Read,
+                                  0,
+                                  impl::kTimestampsSize,
+                                  wgpu::CallbackMode::AllowProcessEvents,
+                                  [timer = weak_from_this(),
+                                   index,
+                                   generation = fGeneration](wgpu::MapAsyncStatus iStatus, auto const &) {
+                                    if(auto t = timer.lock())
+                                      t->onBufferMapped(index, generation, iStatus == wgpu::MapAsyncStatus::Success);
+                                  });
+}
+
+//------------------------------------------------------------------------
+// PassTimer::onBufferMapped
+//------------------------------------------------------------------------
+void PassTimer::onBufferMapped(std::size_t iIndex, generation_t iGeneration, bool iSuccess)
+{
+  auto &readbackBuffer = fReadbackBuffers[iIndex];
+
+  if(iSuccess)
+  {
+    if(iGeneration == fGeneration)
+    {
+      auto timestamps = static_cast<std::uint64_t const *>(readbackBuffer.fBuffer.GetConstMappedRange(0, impl::kTimestampsSize));
+      // timestamps are in nanoseconds (they may be quantized, and are not guaranteed to be monotonic)
+      if(timestamps && timestamps[1] >= timestamps[0])
+        fHistory.add(static_cast<double>(timestamps[1] - timestamps[0]) / 1e6);
+    }
+    readbackBuffer.fBuffer.Unmap();
+  }
+
+  readbackBuffer.fState = ReadbackBufferState::kFree;
+}
+
+//------------------------------------------------------------------------
+// PassTimer::reset
+//------------------------------------------------------------------------
+void PassTimer::reset()
+{
+  fGeneration++;
+  fHistory.clear();
+}
+
+}
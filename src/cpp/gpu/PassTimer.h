@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#ifndef WGPU_SHADER_TOY_GPU_PASS_TIMER_H
+#define WGPU_SHADER_TOY_GPU_PASS_TIMER_H
+
+#include <webgpu/webgpu_cpp.h>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "../utils/Timings.h"
+
+namespace pongasoft::gpu {
+
+/**
+ * Measures the time the GPU spends executing a render pass using timestamp queries (only available when the device
+ * has the `timestamp-query` feature, see `isAvailable`).
+ *
+ * At most one pass is measured per frame (the first one): the timestamps written at the beginning and the end of the
+ * pass are resolved right after it (in the same command encoder) into a readback buffer which is mapped
+ * asynchronously once the frame has been submitted (`readback`). The readback buffers are pooled so that measuring a
+ * frame never waits for the previous ones (when they are all in use, the frame is simply not measured).
+ *
+ * Usage: `GPU::renderPass(..., passTimer)` then `passTimer->readback()` after `GPU::endFrame`. */
+class PassTimer : public std::enable_shared_from_this<PassTimer>
+{
+public:
+  static constexpr std::size_t kReadbackBufferCount = 3;
+
+public:
+  explicit PassTimer(wgpu::Device iDevice);
+  ~PassTimer();
+
+  // whether the device supports timestamp queries (otherwise nothing is ever measured)
+  inline bool isAvailable() const { return fQuerySet != nullptr; }
+
+  // returns the timestamp writes to attach to the pass (`nullptr` when this pass is not measured)
+  wgpu::PassTimestampWrites const *beginPass();
+  // resolves the timestamps written by the pass (only when `beginPass` did not return `nullptr`)
+  void endPass(wgpu::CommandEncoder const &iEncoder);
+  // maps the readback buffer of the pass measured in the frame that was just submitted
+  void readback();
+
+  // durations (in milliseconds) of the last measured passes
+  utils::TimingHistory const &getHistory() const { return fHistory; }
+  // the results of the passes in flight are dropped (for example when what is being measured changes)
+  void reset();
+
+private:
+  enum class ReadbackBufferState { kFree, kEncoded, kMapping };
+
+  struct ReadbackBuffer
+  {
+    wgpu::Buffer fBuffer{};
+    ReadbackBufferState fState{ReadbackBufferState::kFree};
+  };
+
+  using generation_t = std::uint64_t;
+
+  void onBufferMapped(std::size_t iIndex, generation_t iGeneration, bool iSuccess);
+
+private:
+  wgpu::Device fDevice;
+  wgpu::QuerySet fQuerySet{};
+  wgpu::Buffer fResolveBuffer{};
+  wgpu::PassTimestampWrites fTimestampWrites{};
+  std::vector<ReadbackBuffer> fReadbackBuffers{};
+  // the buffer reserved by `beginPass` for the current frame
+  std::optional<std::size_t> fEncodedIndex{};
+  generation_t fGeneration{};
+  utils::TimingHistory fHistory{};
+};
+
+}
+
+#endif //WGPU_SHADER_TOY_GPU_PASS_TIMER_H
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include "ReadbackPool.h"
+#include "../Errors.h"
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+namespace pongasoft::gpu {
+
+//------------------------------------------------------------------------
+// ReadbackPool::ReadbackPool
+//------------------------------------------------------------------------
+ReadbackPool::ReadbackPool(wgpu::Device iDevice, std::size_t iMaxBufferCount) :
+  fDevice{std::move(iDevice)},
+  fMaxBufferCount{std::max<std::size_t>(iMaxBufferCount, 1)}
+{
+}
+
+//------------------------------------------------------------------------
+// ReadbackPool::isAvailable
+//------------------------------------------------------------------------
+bool ReadbackPool::isAvailable() const
+{
+  return getInFlightCount() < fMaxBufferCount;
+}
+
+//------------------------------------------------------------------------
+// ReadbackPool::getInFlightCount
+//------------------------------------------------------------------------
+std::size_t ReadbackPool::getInFlightCount() const
+{
+  return std::ranges::count(fBuffers, true, &StagingBuffer::fInUse);
+}
+
+//------------------------------------------------------------------------
+// ReadbackPool::acquireBuffer
+// Returns the index of a free buffer of at least `iSize` bytes (reused when possible)
+//------------------------------------------------------------------------
+std::size_t ReadbackPool::acquireBuffer(std::uint64_t iSize)
+{
+  std::optional<std::size_t> free{};
+  for(std::size_t i = 0; i < fBuffers.size(); i++)
+  {
+    if(!fBuffers[i].fInUse)
+    {
+      if(fBuffers[i].fSize >= iSize)
+        return i;
+      free = i;
+    }
+  }
+
+  wgpu::BufferDescriptor descriptor{
+    .label = "ReadbackPool | Staging Buffer",
+    .usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead,
+    .size = iSize
+  };
+
+  // too small: replaced by a bigger one
+  if(free)
+  {
+    fBuffers[*free].fBuffer.Destroy();
+    fBuffers[*free] = StagingBuffer{.fBuffer = fDevice.CreateBuffer(&descriptor), .fSize = iSize};
+    return *free;
+  }
+
+  fBuffers.emplace_back(StagingBuffer{.fBuffer = fDevice.CreateBuffer(&descriptor), .fSize = iSize});
+  return fBuffers.size() - 1;
+}
+
+//------------------------------------------------------------------------
+// ReadbackPool::submit
+//------------------------------------------------------------------------
+void ReadbackPool::submit(wgpu::CommandEncoder const &iEncoder,
+                          wgpu::Texture const &iTexture,
+                          std::uint32_t iWidth,
+                          std::uint32_t iHeight,
+                          callback_t iCallback)
+{
+  WST_INTERNAL_ASSERT(isAvailable(), "No staging buffer available (check isAvailable)");
+
+  auto const bytesPerRow = computeBytesPerRow(iWidth);
+  auto const size = static_cast<std::uint64_t>(bytesPerRow) * iHeight;
+  auto const index = acquireBuffer(size);
+  auto &stagingBuffer = fBuffers[index];
+  stagingBuffer.fInUse = true;
+  stagingBuffer.fMappedSize = size;
+  stagingBuffer.fBytesPerRow = bytesPerRow;
+  stagingBuffer.fCallback = std::move(iCallback);
+
+  wgpu::TexelCopyTextureInfo source{.texture = iTexture};
+  wgpu::TexelCopyBufferInfo destination{
+    .layout = {
+      .bytesPerRow = bytesPerRow,
+      .rowsPerImage = iHeight
+    },
+    .buffer = stagingBuffer.fBuffer
+  };
+  wgpu::Extent3D extent{iWidth, iHeight, 1};
+  iEncoder.CopyTextureToBuffer(&source, &destination, &extent);
+
+  auto commands = iEncoder.Finish();
+  fDevice.GetQueue().Submit(1, &commands);
+
+  stagingBuffer.fBuffer.MapAsync(wgpu::MapMode::Read,
+                                 0,
+                                 size,
+                                 wgpu::CallbackMode::AllowProcessEvents,
+                                 [pool = weak_from_this(),
+                                  index,
+                                  generation = fGeneration](wgpu::MapAsyncStatus iStatus, auto const &) {
+                                   if(auto p = pool.lock())
+                                     p->onBufferMapped(index, generation, iStatus == wgpu::MapAsyncStatus::Success);
+                                 });
+}
+
+//------------------------------------------------------------------------
+// ReadbackPool::onBufferMapped
+//------------------------------------------------------------------------
+void ReadbackPool::onBufferMapped(std::size_t iIndex, generation_t iGeneration, bool iSuccess)
+{
+  auto callback = std::exchange(fBuffers[iIndex].fCallback, nullptr);
+  auto const bytesPerRow = fBuffers[iIndex].fBytesPerRow;
+
+  if(iGeneration == fGeneration && callback)
+  {
+    // only the mapped range is accessible (the whole buffer is not mapped when it is bigger than the readback)
+    auto data = iSuccess ?
+                static_cast<std::uint8_t const *>(fBuffers[iIndex].fBuffer.GetConstMappedRange(0, fBuffers[iIndex].fMappedSize)) :
+                nullptr;
+    // Note: the callback may submit new readbacks (which may add buffers): the buffer is still in use until unmapped
+    callback(data, bytesPerRow);
+  }
+
+  if(iSuccess)
+    fBuffers[iIndex].fBuffer.Unmap();
+  fBuffers[iIndex].fInUse = false;
+}
+
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#ifndef WGPU_SHADER_TOY_GPU_READBACK_POOL_H
+#define WGPU_SHADER_TOY_GPU_READBACK_POOL_H
+
+#include <webgpu/webgpu_cpp.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace pongasoft::gpu {
+
+/**
+ * Pool of staging buffers used to read back (the content of) textures without ever blocking: the copy is recorded at
+ * the end of the commands being submitted and the staging buffer is mapped asynchronously (the callback is invoked
+ * from `GPU::pollEvents` once the GPU is done).
+ *
+ * At most `iMaxBufferCount` readbacks are in flight: callers must check `isAvailable` before submitting (which is
+ * how they are throttled to the speed of the GPU). */
+class ReadbackPool : public std::enable_shared_from_this<ReadbackPool>
+{
+public:
+  // `iData` (rows of `iBytesPerRow` bytes) is only valid during the call (`nullptr` when the readback failed)
+  using callback_t = std::function<void(std::uint8_t const *iData, std::uint32_t iBytesPerRow)>;
+
+  // rows must be aligned on 256 bytes when copying a texture into a buffer
+  static constexpr std::uint32_t computeBytesPerRow(std::uint32_t iWidth, std::uint32_t iBytesPerPixel = 4)
+  {
+    return (iWidth * iBytesPerPixel + 255) & ~255u;
+  }
+
+public:
+  ReadbackPool(wgpu::Device iDevice, std::size_t iMaxBufferCount);
+
+  // whether a staging buffer is available for the next readback
+  bool isAvailable() const;
+  std::size_t getInFlightCount() const;
+
+  // copies the (top left) `iWidth` x `iHeight` area of the texture after the commands recorded in `iEncoder`,
+  // submits them and invokes the callback once the data is available
+  void submit(wgpu::CommandEncoder const &iEncoder,
+              wgpu::Texture const &iTexture,
+              std::uint32_t iWidth,
+              std::uint32_t iHeight,
+              callback_t iCallback);
+
+  // the callbacks of the readbacks in flight are dropped (their buffers are recycled once mapped)
+  void cancel() { fGeneration++; }
+
+private:
+  struct StagingBuffer
+  {
+    wgpu::Buffer fBuffer{};
+    std::uint64_t fSize{};
+    bool fInUse{};
+    std::uint64_t fMappedSize{}; // size of the readback in flight (a reused buffer may be bigger)
+    std::uint32_t fBytesPerRow{};
+    callback_t fCallback{};
+  };
+
+  using generation_t = std::uint64_t;
+
+  std::size_t acquireBuffer(std::uint64_t iSize);
+  void onBufferMapped(std::size_t iIndex, generation_t iGeneration, bool iSuccess);
+
+private:
+  wgpu::Device fDevice;
+  std::size_t fMaxBufferCount;
+  std::vector<StagingBuffer> fBuffers{};
+  generation_t fGeneration{};
+};
+
+}
+
+#endif //WGPU_SHADER_TOY_GPU_READBACK_POOL_H
@@ -20,6 +20,10 @@
 #define WGPU_SHADER_TOY_GPU_RENDERABLE_H
 
 #include "GPU.h"
+#include "PassTimer.h"
+#include "Size.h"
+#include "../utils/Timings.h"
+#include <algorithm>
 
 namespace pongasoft::gpu {
 
@@ -29,11 +33,15 @@ public:
   using render_fn_t = std::function<void()>;
 
 public:
-  struct Size
+  using Size = gpu::Size;
+
+  // [Cadence] limits how often a new frame is rendered, independently of the other renderables
+  struct Cadence
   {
-    int width{};
-    int height{};
+    int fFrameInterval{1}; // renders (at most) every Nth iteration of the main loop
+    int fMaxFPS{};         // 0 means no limit
   };
+
 public:
   explicit Renderable(std::shared_ptr<GPU> iGPU) : fGPU{std::move(iGPU)} {}
   virtual ~Renderable() = default;
@@ -43,16 +51,41 @@ public:
   virtual bool running() const { return true; }
 
   virtual void render() {
+    if(fRenderRequestFrameCount > 0)
+      fRenderRequestFrameCount--;
+    fIterationsSinceLastFrame = 0;
+    fLastFrameTime = fCadenceTime;
     fGPU->renderPass(fClearColor, [this](wgpu::RenderPassEncoder &renderPass) {
       doRender(renderPass);
-    }, getTextureView());
+    }, getTextureView(), wgpu::LoadOp::Clear, getSurfacePassTimer());
+  }
+
+  // [On-demand rendering] When enabled, a new frame is rendered only when requested or when something changed
+  // (see isDirty). Otherwise, a new frame is rendered every time.
+  constexpr bool isRenderOnDemand() const { return fRenderOnDemand; }
+  virtual void setRenderOnDemand(bool iRenderOnDemand) { fRenderOnDemand = iRenderOnDemand; requestRender(); }
+  virtual bool needsRender() const { return fFrameDue && (!fRenderOnDemand || fRenderRequestFrameCount > 0 || isDirty()); }
+  void requestRender(int iFrameCount = 1) { fRenderRequestFrameCount = std::max(fRenderRequestFrameCount, iFrameCount); }
+
+  constexpr Cadence const &getCadence() const { return fCadence; }
+  void setCadence(Cadence const &iCadence) {
+    fCadence = {std::max(1, iCadence.fFrameInterval), std::max(0, iCadence.fMaxFPS)};
+    fFrameDue = true;
   }
+  // whether the cadence allows rendering a new frame during this iteration of the main loop (see updateCadence)
+  constexpr bool isFrameDue() const { return fFrameDue; }
+
+  // CPU timings of the phases of a frame (recorded by whoever drives this renderable)
+  utils::PhaseTimings &getPhaseTimings() { return fPhaseTimings; }
+  utils::PhaseTimings const &getPhaseTimings() const { return fPhaseTimings; }
 
   wgpu::Color const &getClearColor() const { return fClearColor;}
   void setClearColor(wgpu::Color const &iClearColor) { fClearColor = gammaCorrect(iClearColor); }
 
 protected:
   virtual void doRender(wgpu::RenderPassEncoder &iRenderPass) = 0;
+  // whether the content changed since the last frame was rendered (only used with on-demand rendering)
+  virtual bool isDirty() const { return false; }
 
   void initPreferredFormat(wgpu::TextureFormat iPreferredFormat)
   {
@@ -61,6 +94,19 @@ protected:
   }
 
   virtual wgpu::TextureView getTextureView() const = 0;
+  // [GPU timing] the timer of the pass rendering into the texture view (`nullptr` when it must not be measured)
+  virtual PassTimer *getSurfacePassTimer() const { return fPassTimer.get(); }
+
+  // must be called once per iteration of the main loop (before needsRender)
+  void updateCadence(double iCurrentTime)
+  {
+    fCadenceTime = iCurrentTime;
+    fIterationsSinceLastFrame++;
+    fFrameDue = fIterationsSinceLastFrame >= fCadence.fFrameInterval;
+    // some tolerance so that a limit matching a divisor of the display refresh rate is not missed due to jitter
+    if(fFrameDue && fCadence.fMaxFPS > 0)
+      fFrameDue = iCurrentTime - fLastFrameTime >= 0.9 / fCadence.fMaxFPS;
+  }
 
   inline double gammaCorrect(double f) const {
     if(fGamma == 1.0)
@@ -78,6 +124,18 @@ protected:
   wgpu::Color fClearColor{};
   wgpu::TextureFormat fPreferredFormat{wgpu::TextureFormat::Undefined};
   float fGamma{1.0};
+  utils::PhaseTimings fPhaseTimings{};
+  // [GPU timing] optional (measures the first pass of each frame)
+  std::shared_ptr<PassTimer> fPassTimer{};
+
+private:
+  bool fRenderOnDemand{false};
+  int fRenderRequestFrameCount{};
+  Cadence fCadence{};
+  bool fFrameDue{true};
+  int fIterationsSinceLastFrame{};
+  double fCadenceTime{};
+  double fLastFrameTime{};
 };
 
 template<typename T>
@@ -20,6 +20,7 @@
 #include "../Errors.h"
 #include <GLFW/glfw3.h>
 #include <GLFW/emscripten_glfw3.h>
+#include <algorithm>
 
 namespace pongasoft::gpu {
 
@@ -70,6 +71,8 @@ Window::Window(std::shared_ptr<GPU> iGPU, Args const &iArgs) :
   wgpu::SurfaceCapabilities capabilities;
   fSurface.GetCapabilities(fGPU->getAdapter(), &capabilities);
   initPreferredFormat(capabilities.formatCount > 0 ? capabilities.formats[0] : wgpu::TextureFormat::BGRA8Unorm);
+  fSupportedPresentModes.assign(capabilities.presentModes, capabilities.presentModes + capabilities.presentModeCount);
+  fSupportedAlphaModes.assign(capabilities.alphaModes, capabilities.alphaModes + capabilities.alphaModeCount);
 
   // will initialize the swapchain on first frame
   int w, h;
@@ -112,6 +115,7 @@ Renderable::Size Window::getSize() const
 //------------------------------------------------------------------------
 void Window::beforeFrame()
 {
+  updateCadence(getCurrentTime());
   handleFramebufferSizeChange();
 }
 
@@ -122,8 +126,14 @@ void Window::handleFramebufferSizeChange()
 {
   if(fNewFrameBufferSize)
   {
+    // the change is deferred (not dropped): the last size is always handled once the settle period is over
+    auto const now = getCurrentTime();
+    if(now - fLastFrameBufferSizeChangeTime < kResizeSettlePeriod)
+      return;
+    fLastFrameBufferSizeChangeTime = now;
     doHandleFrameBufferSizeChange(*fNewFrameBufferSize);
     fNewFrameBufferSize = std::nullopt;
+    requestRender();
   }
 }
 
@@ -147,10 +157,57 @@ void Window::configureSurface(Size const &iSize)
   config.usage = wgpu::TextureUsage::RenderAttachment;
   config.width = iSize.width;
   config.height = iSize.height;
-  config.presentMode = wgpu::PresentMode::Fifo;
-  config.alphaMode = wgpu::CompositeAlphaMode::Auto;
+  config.presentMode = fPresentMode;
+  config.alphaMode = fAlphaMode;
 
   fSurface.Configure(&config);
+  fSurfaceSize = iSize;
+}
+
+//------------------------------------------------------------------------
+// Window::setPresentMode
+//------------------------------------------------------------------------
+void Window::setPresentMode(wgpu::PresentMode iPresentMode)
+{
+  // Fifo is the only present mode guaranteed to be supported
+  auto presentMode = std::ranges::contains(fSupportedPresentModes, iPresentMode) ? iPresentMode : wgpu::PresentMode::Fifo;
+  if(presentMode == fPresentMode)
+    return;
+  fPresentMode = presentMode;
+  if(fSurfaceSize)
+    configureSurface(*fSurfaceSize);
+  requestRender();
+}
+
+//------------------------------------------------------------------------
+// Window::setOpaque
+//------------------------------------------------------------------------
+void Window::setOpaque(bool iOpaque)
+{
+  auto alphaMode = iOpaque && std::ranges::contains(fSupportedAlphaModes, wgpu::CompositeAlphaMode::Opaque) ?
+                   wgpu::CompositeAlphaMode::Opaque : wgpu::CompositeAlphaMode::Auto;
+  if(alphaMode == fAlphaMode)
+    return;
+  fAlphaMode = alphaMode;
+  if(fSurfaceSize)
+    configureSurface(*fSurfaceSize);
+  requestRender();
+}
+
+//------------------------------------------------------------------------
+// Window::presentModeFromString
+//------------------------------------------------------------------------
+std::optional<wgpu::PresentMode> Window::presentModeFromString(std::string_view iPresentMode)
+{
+  for(auto presentMode: {wgpu::PresentMode::Fifo,
+                         wgpu::PresentMode::FifoRelaxed,
+                         wgpu::PresentMode::Immediate,
+                         wgpu::PresentMode::Mailbox})
+  {
+    if(iPresentMode == presentModeAsString(presentMode))
+      return presentMode;
+  }
+  return std::nullopt;
 }
 
 //------------------------------------------------------------------------
@@ -21,6 +21,8 @@
 
 #include "Renderable.h"
 #include <optional>
+#include <vector>
+#include <string_view>
 #include <GLFW/glfw3.h>
 
 namespace pongasoft::gpu {
@@ -28,6 +30,10 @@ namespace pongasoft::gpu {
 class Window: public Renderable
 {
 public:
+  // during an interactive resize, the size changes at (almost) every frame: the change is handled at most once per
+  // settle period (in seconds)
+  static constexpr double kResizeSettlePeriod = 0.1;
+
   // Types
   struct Args
   {
@@ -76,8 +82,38 @@ public:
 
   inline GLFWwindow *asOpaquePtr() const { return fWindow; }
 
+  // [Frame pacing] the present mode is negotiated with the capabilities of the surface (Fifo is always supported)
+  std::vector<wgpu::PresentMode> const &getSupportedPresentModes() const { return fSupportedPresentModes; }
+  constexpr wgpu::PresentMode getPresentMode() const { return fPresentMode; }
+  virtual void setPresentMode(wgpu::PresentMode iPresentMode);
+  // an opaque surface ignores the alpha channel which makes composition (by the browser) cheaper
+  constexpr bool isOpaque() const { return fAlphaMode == wgpu::CompositeAlphaMode::Opaque; }
+  virtual void setOpaque(bool iOpaque);
+
   static double getCurrentTime();
 
+  //------------------------------------------------------------------------
+  // Window::presentModeAsString
+  //------------------------------------------------------------------------
+  constexpr static char const *presentModeAsString(wgpu::PresentMode iPresentMode)
+  {
+    switch(iPresentMode)
+    {
+      case wgpu::PresentMode::Fifo:
+        return "Fifo";
+      case wgpu::PresentMode::FifoRelaxed:
+        return "FifoRelaxed";
+      case wgpu::PresentMode::Immediate:
+        return "Immediate";
+      case wgpu::PresentMode::Mailbox:
+        return "Mailbox";
+      default:
+        return "Unknown";
+    }
+  }
+
+  static std::optional<wgpu::PresentMode> presentModeFromString(std::string_view iPresentMode);
+
 protected:
   wgpu::TextureView getTextureView() const override;
 
@@ -90,7 +126,13 @@ protected:
 
 private:
   std::optional<Size> fNewFrameBufferSize{};
+  double fLastFrameBufferSizeChangeTime{-kResizeSettlePeriod}; // the very first change is handled right away
   wgpu::Surface fSurface{};
+  std::optional<Size> fSurfaceSize{};
+  std::vector<wgpu::PresentMode> fSupportedPresentModes{};
+  std::vector<wgpu::CompositeAlphaMode> fSupportedAlphaModes{};
+  wgpu::PresentMode fPresentMode{wgpu::PresentMode::Fifo};
+  wgpu::CompositeAlphaMode fAlphaMode{wgpu::CompositeAlphaMode::Auto};
 };
 
 }
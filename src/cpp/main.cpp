@@ -136,7 +136,8 @@ static void WaitLoopForApplication()
                                                        },
                                                        .defaultState = defaultState,
                                                        .state = state,
-                                                       .preferences = preferences
+                                                       .preferences = preferences,
+                                                       .mainLoopTimings = kApplication->getMainLoopTimings()
                                                      })
         ->show();
     }
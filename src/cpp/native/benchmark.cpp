@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+// Micro-benchmarks of the (non GPU) hot paths of the core: saving/loading a project, decompressing the embedded
+// font, undo/redo and building the state (what MainWindow::computeState does). Results are emitted as JSON (on stdout
+// or in a file) so that runs can be compared.
+//
+// Usage: wgpu_shader_toy_benchmark [output.json] [min time per benchmark in ms (default 200)]
+
+#include "Preferences.h"
+#include "State.h"
+#include "utils/DataManager.h"
+#include "utils/UndoManager.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "JetBrainsMono-Regular.cpp"
+
+using namespace pongasoft;
+using json = nlohmann::json;
+
+namespace shader_toy {
+// defined in FragmentShaderExamples.cpp
+extern std::vector<Shader> kBuiltInFragmentShaderExamples;
+}
+
+namespace shader_toy::benchmark {
+
+using clock_t = std::chrono::steady_clock;
+
+// prevents the compiler from optimizing away the computation being measured
+template<typename T>
+inline void doNotOptimize(T const &iValue)
+{
+  asm volatile("" : : "r,m"(iValue) : "memory");
+}
+
+//------------------------------------------------------------------------
+// Runner
+// Runs each benchmark (after a warm-up) until it has run for a minimum amount of time and collects the statistics
+//------------------------------------------------------------------------
+class Runner
+{
+public:
+  explicit Runner(std::chrono::nanoseconds iMinTime) : fMinTime{iMinTime} {}
+
+  void run(std::string const &iName, json iParameters, std::function<void()> const &iFunction)
+  {
+    // warm-up (caches, allocator...)
+    for(int i = 0; i < kWarmUpIterations; i++)
+      iFunction();
+
+    std::vector<double> samples{};
+    auto start = clock_t::now();
+    while(samples.size() < kMinIterations || clock_t::now() - start < fMinTime)
+    {
+      auto t0 = clock_t::now();
+      iFunction();
+      samples.emplace_back(std::chrono::duration<double, std::nano>(clock_t::now() - t0).count());
+    }
+
+    std::ranges::sort(samples);
+    double total{};
+    for(auto s: samples)
+      total += s;
+    auto percentile = [&samples](double p) {
+      return samples[std::min(samples.size() - 1, static_cast<std::size_t>(p * static_cast<double>(samples.size())))];
+    };
+
+    std::fprintf(stderr, "%-40s %-24s %12.0fns (median %.0fns, %zu iterations)\n",
+                 iName.c_str(), iParameters.dump().c_str(), total / static_cast<double>(samples.size()),
+                 percentile(0.5), samples.size());
+
+    fResults.push_back({
+                         {"name",       iName},
+                         {"parameters", std::move(iParameters)},
+                         {"iterations", samples.size()},
+                         {"mean_ns",    total / static_cast<double>(samples.size())},
+                         {"min_ns",     samples.front()},
+                         {"median_ns",  percentile(0.5)},
+                         {"p95_ns",     percentile(0.95)},
+                         {"max_ns",     samples.back()},
+                       });
+  }
+
+  json const &getResults() const { return fResults; }
+
+private:
+  static constexpr int kWarmUpIterations = 3;
+  static constexpr std::size_t kMinIterations = 10;
+
+  std::chrono::nanoseconds fMinTime;
+  json fResults = json::array();
+};
+
+//------------------------------------------------------------------------
+// createShaders
+// Generates `iCount` shaders from the built-in examples (as if the user had created many variations)
+//------------------------------------------------------------------------
+std::vector<Shader> createShaders(std::size_t iCount)
+{
+  std::vector<Shader> res{};
+  res.reserve(iCount);
+  for(std::size_t i = 0; i < iCount; i++)
+  {
+    auto const &example = kBuiltInFragmentShaderExamples[i % kBuiltInFragmentShaderExamples.size()];
+    res.emplace_back(Shader{
+      .fName = example.fName + " " + std::to_string(i),
+      .fCode = example.fCode,
+      .fEditedCode = i % 2 == 0 ? std::optional<std::string>(example.fCode + "\n// edited\n") : std::nullopt,
+      .fWindowSize = {1280, 720}
+    });
+  }
+  return res;
+}
+
+//------------------------------------------------------------------------
+// computeState
+// Equivalent of MainWindow::computeState (which walks its fragment shaders and copies their name and code)
+//------------------------------------------------------------------------
+State computeState(State::Settings const &iSettings, std::vector<Shader> const &iShaders)
+{
+  State::Shaders shaders{
+    .fCurrent = iShaders.empty() ? std::nullopt : std::optional<std::string>(iShaders.back().fName)
+  };
+
+  for(auto const &shader: iShaders)
+  {
+    shaders.fList.emplace_back(Shader{
+      .fName = shader.fName,
+      .fCode = shader.fCode,
+      .fEditedCode = shader.fEditedCode,
+      .fWindowSize = shader.fWindowSize,
+      .fOverrideValues = shader.fOverrideValues}
+    );
+  }
+
+  return {
+    .fSettings = iSettings,
+    .fShaders = std::move(shaders)
+  };
+}
+
+//------------------------------------------------------------------------
+// SetValueAction
+// Action holding a copy of the state before and after (like MainWindow's UpdateStateAction)
+//------------------------------------------------------------------------
+class SetValueAction : public utils::ExecutableAction<void>
+{
+public:
+  void init(std::vector<int> &iTarget, std::vector<int> iNewValue)
+  {
+    fTarget = &iTarget;
+    fOldValue = iTarget;
+    fNewValue = std::move(iNewValue);
+  }
+
+  void execute() override { *fTarget = fNewValue; }
+  void undo() override { *fTarget = fOldValue; }
+
+private:
+  std::vector<int> *fTarget{};
+  std::vector<int> fOldValue{};
+  std::vector<int> fNewValue{};
+};
+
+//------------------------------------------------------------------------
+// runPreferencesBenchmarks
+//------------------------------------------------------------------------
+void runPreferencesBenchmarks(Runner &iRunner)
+{
+  for(std::size_t count: {1, 10, 100, 1000})
+  {
+    auto state = computeState({}, createShaders(count));
+    auto serialized = Preferences::serialize(state);
+    json parameters{{"shaders", count}, {"bytes", serialized.size()}};
+
+    iRunner.run("Preferences::serialize", parameters, [&state] {
+      doNotOptimize(Preferences::serialize(state));
+    });
+
+    iRunner.run("Preferences::deserialize", parameters, [&serialized] {
+      doNotOptimize(Preferences::deserialize(serialized, {}));
+    });
+  }
+}
+
+//------------------------------------------------------------------------
+// runDataManagerBenchmarks
+//------------------------------------------------------------------------
+void runDataManagerBenchmarks(Runner &iRunner)
+{
+  auto size = utils::DataManager::loadCompressedBase85(JetBrainsMonoRegular_compressed_data_base85).size();
+  iRunner.run("DataManager::loadCompressedBase85", {{"font", "JetBrainsMono-Regular"}, {"bytes", size}}, [] {
+    doNotOptimize(utils::DataManager::loadCompressedBase85(JetBrainsMonoRegular_compressed_data_base85));
+  });
+}
+
+//------------------------------------------------------------------------
+// runUndoManagerBenchmarks
+//------------------------------------------------------------------------
+void runUndoManagerBenchmarks(Runner &iRunner)
+{
+  constexpr std::size_t kValueSize = 64;
+
+  for(std::size_t depth: {10, 100, 1000, 10000})
+  {
+    json parameters{{"depth", depth}};
+
+    iRunner.run("UndoManager::executeAction", parameters, [depth] {
+      utils::UndoManager undoManager{};
+      std::vector<int> value(kValueSize);
+      for(std::size_t i = 0; i < depth; i++)
+        undoManager.executeAction<SetValueAction>(value, std::vector<int>(kValueSize, static_cast<int>(i)));
+      doNotOptimize(value);
+    });
+
+    // the history is built once: each iteration undoes then redoes the whole history (leaving it unchanged)
+    utils::UndoManager undoManager{};
+    std::vector<int> value(kValueSize);
+    for(std::size_t i = 0; i < depth; i++)
+      undoManager.executeAction<SetValueAction>(value, std::vector<int>(kValueSize, static_cast<int>(i)));
+
+    iRunner.run("UndoManager::undo/redo", parameters, [depth, &undoManager, &value] {
+      for(std::size_t i = 0; i < depth; i++)
+        undoManager.undoLastAction();
+      for(std::size_t i = 0; i < depth; i++)
+        undoManager.redoLastAction();
+      doNotOptimize(value);
+    });
+
+    iRunner.run("UndoManager::tx", parameters, [depth] {
+      utils::UndoManager undoManager{};
+      std::vector<int> value(kValueSize);
+      undoManager.beginTx("tx");
+      for(std::size_t i = 0; i < depth; i++)
+        undoManager.executeAction<SetValueAction>(value, std::vector<int>(kValueSize, static_cast<int>(i)));
+      undoManager.commitTx();
+      undoManager.undoAll();
+      doNotOptimize(value);
+    });
+  }
+}
+
+//------------------------------------------------------------------------
+// runStateBenchmarks
+//------------------------------------------------------------------------
+void runStateBenchmarks(Runner &iRunner)
+{
+  State::Settings settings{};
+  for(std::size_t count: {1, 10, 100, 1000})
+  {
+    auto shaders = createShaders(count);
+    iRunner.run("MainWindow::computeState", {{"shaders", count}}, [&settings, &shaders] {
+      doNotOptimize(computeState(settings, shaders));
+    });
+  }
+}
+
+}
+
+//------------------------------------------------------------------------
+// main
+//------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  using namespace shader_toy::benchmark;
+
+  std::chrono::milliseconds minTime{200};
+  if(argc > 2)
+    minTime = std::chrono::milliseconds{std::max(1, std::atoi(argv[2]))};
+
+  Runner runner{minTime};
+  runPreferencesBenchmarks(runner);
+  runDataManagerBenchmarks(runner);
+  runUndoManagerBenchmarks(runner);
+  runStateBenchmarks(runner);
+
+  json output{
+#ifdef NDEBUG
+    {"build", "release"},
+#else
+    {"build", "debug"},
+#endif
+    {"benchmarks", runner.getResults()}
+  };
+
+  if(argc > 1 && std::string_view{argv[1]} != "-")
+  {
+    std::ofstream file{argv[1]};
+    if(!file)
+    {
+      std::fprintf(stderr, "Cannot write %s\n", argv[1]);
+      return 1;
+    }
+    file << output.dump(2) << std::endl;
+  }
+  else
+    std::printf("%s\n", output.dump(2).c_str());
+
+  return 0;
+}
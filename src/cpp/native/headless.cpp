@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+// Headless (native) renderer: renders a fragment shader offscreen for a number of frames using a software adapter so
+// that the GPU layer can be profiled with native tools on a machine without a GPU.
+//
+// Usage: wgpu_shader_toy_headless <shader.wgsl> [width] [height] [frames]
+
+#include "gpu/GPU.h"
+#include "gpu/ReadbackPool.h"
+#include "ShaderToyWGSL.h"
+#include "fmt.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+
+using namespace pongasoft;
+
+namespace shader_toy::headless {
+
+// Note: must match the layout of ShaderToyInputs in kShaderToyHeader
+struct ShaderToyInputs
+{
+  float size[4]{};
+  float mouse[4]{-1, -1, -1, -1};
+  float time{};
+  std::int32_t frame{};
+  float offset[2]{};
+};
+
+static_assert(sizeof(ShaderToyInputs) == 48);
+
+//------------------------------------------------------------------------
+// readFile
+//------------------------------------------------------------------------
+std::optional<std::string> readFile(char const *iFilename)
+{
+  std::ifstream file{iFilename, std::ios::binary};
+  if(!file)
+    return std::nullopt;
+  std::ostringstream content{};
+  content << file.rdbuf();
+  return content.str();
+}
+
+//------------------------------------------------------------------------
+// createGPU
+// Waits (processing events) until the device is created
+//------------------------------------------------------------------------
+std::shared_ptr<gpu::GPU> createGPU()
+{
+  std::shared_ptr<gpu::GPU> res{};
+  bool done = false;
+  auto gpu = gpu::GPU::asyncCreate([&res, &done](std::shared_ptr<gpu::GPU> iGPU) {
+                                     res = std::move(iGPU);
+                                     done = true;
+                                   },
+                                   [&done](wgpu::StringView iMessage) {
+                                     std::fprintf(stderr, "Cannot create GPU: %.*s\n",
+                                                  static_cast<int>(iMessage.length), iMessage.data);
+                                     done = true;
+                                   },
+                                   true);
+  while(!done)
+    gpu->pollEvents();
+  return res;
+}
+
+//------------------------------------------------------------------------
+// compileShader
+// Returns `nullptr` (after printing the errors) when the shader does not compile
+//------------------------------------------------------------------------
+wgpu::ShaderModule compileShader(gpu::GPU &iGPU, std::string const &iCode)
+{
+  auto code = std::string(kShaderToyHeader) + iCode;
+  wgpu::ShaderSourceWGSL source{};
+  source.code = code.c_str();
+  wgpu::ShaderModuleDescriptor descriptor{.nextInChain = &source, .label = "Headless | Fragment Shader"};
+  auto module = iGPU.getDevice().CreateShaderModule(&descriptor);
+
+  bool done = false;
+  bool success = false;
+  module.GetCompilationInfo(wgpu::CallbackMode::AllowProcessEvents,
+                            [&done, &success](wgpu::CompilationInfoRequestStatus iStatus,
+                                              wgpu::CompilationInfo const *iCompilationInfo) {
+                              done = true;
+                              success = iStatus == wgpu::CompilationInfoRequestStatus::Success;
+                              if(!iCompilationInfo)
+                                return;
+                              for(std::size_t i = 0; i < iCompilationInfo->messageCount; i++)
+                              {
+                                auto const &message = iCompilationInfo->messages[i];
+                                if(message.type == wgpu::CompilationMessageType::Error)
+                                {
+                                  std::fprintf(stderr, "Error line %d:%d | %.*s\n",
+                                               static_cast<int>(message.lineNum),
+                                               static_cast<int>(message.linePos),
+                                               static_cast<int>(message.message.length), message.message.data);
+                                  success = false;
+                                }
+                              }
+                            });
+  while(!done)
+    iGPU.pollEvents();
+
+  return success ? module : nullptr;
+}
+
+//------------------------------------------------------------------------
+// run
+//------------------------------------------------------------------------
+int run(std::string const &iCode, std::uint32_t iWidth, std::uint32_t iHeight, int iFrameCount)
+{
+  auto gpu = createGPU();
+  if(!gpu)
+    return 1;
+
+  auto device = gpu->getDevice();
+  auto &objectCache = gpu->getObjectCache();
+
+  auto fragmentShaderModule = compileShader(*gpu, iCode);
+  if(!fragmentShaderModule)
+    return 1;
+
+  wgpu::BindGroupLayoutEntry bindGroupLayoutEntry{};
+  bindGroupLayoutEntry.binding = 0;
+  bindGroupLayoutEntry.visibility = wgpu::ShaderStage::Fragment;
+  bindGroupLayoutEntry.buffer.type = wgpu::BufferBindingType::Uniform;
+  auto bindGroupLayout = objectCache.getBindGroupLayout({.entryCount = 1, .entries = &bindGroupLayoutEntry});
+  auto pipelineLayout = objectCache.getPipelineLayout({.bindGroupLayoutCount = 1, .bindGroupLayouts = &bindGroupLayout});
+
+  constexpr auto kFormat = wgpu::TextureFormat::RGBA8Unorm;
+  wgpu::ColorTargetState colorTargetState{.format = kFormat};
+  wgpu::FragmentState fragmentState{
+    .module = fragmentShaderModule,
+    .entryPoint = "fragmentMain",
+    .targetCount = 1,
+    .targets = &colorTargetState
+  };
+  wgpu::RenderPipelineDescriptor renderPipelineDescriptor{
+    .label = "Headless | Pipeline",
+    .layout = pipelineLayout,
+    .vertex{
+      .module = objectCache.getShaderModule(kShaderToyVertexShader, "Headless | Vertex Shader"),
+      .entryPoint = "vertexMain"
+    },
+    .fragment = &fragmentState,
+  };
+  auto pipeline = device.CreateRenderPipeline(&renderPipelineDescriptor);
+
+  wgpu::TextureDescriptor textureDescriptor{
+    .label = "Headless | Frame",
+    .usage = wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::CopySrc,
+    .size = {iWidth, iHeight, 1},
+    .format = kFormat
+  };
+  auto texture = device.CreateTexture(&textureDescriptor);
+  auto textureView = texture.CreateView();
+
+  wgpu::BufferDescriptor inputsBufferDescriptor{
+    .label = "Headless | ShaderToyInputs Buffer",
+    .usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform,
+    .size = sizeof(ShaderToyInputs)
+  };
+  auto inputsBuffer = device.CreateBuffer(&inputsBufferDescriptor);
+  wgpu::BindGroupEntry bindGroupEntry{.binding = 0, .buffer = inputsBuffer, .size = sizeof(ShaderToyInputs)};
+  wgpu::BindGroupDescriptor bindGroupDescriptor{.layout = bindGroupLayout, .entryCount = 1, .entries = &bindGroupEntry};
+  auto bindGroup = device.CreateBindGroup(&bindGroupDescriptor);
+
+  auto readbackPool = std::make_shared<gpu::ReadbackPool>(device, 1);
+  ShaderToyInputs inputs{.size = {static_cast<float>(iWidth), static_cast<float>(iHeight), 1, 1}};
+
+  auto const start = std::chrono::steady_clock::now();
+
+  std::optional<std::uint64_t> checksum{};
+  for(int frame = 0; frame < iFrameCount; frame++)
+  {
+    inputs.time = static_cast<float>(frame) / 60.0f;
+    inputs.frame = frame;
+    device.GetQueue().WriteBuffer(inputsBuffer, 0, &inputs, sizeof(inputs));
+
+    auto encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassColorAttachment attachment{
+      .view = textureView,
+      .loadOp = wgpu::LoadOp::Clear,
+      .storeOp = wgpu::StoreOp::Store,
+      .clearValue = {0, 0, 0, 1}
+    };
+    wgpu::RenderPassDescriptor renderPassDescriptor{.colorAttachmentCount = 1, .colorAttachments = &attachment};
+    auto pass = encoder.BeginRenderPass(&renderPassDescriptor);
+    pass.SetPipeline(pipeline);
+    pass.SetBindGroup(0, bindGroup);
+    pass.Draw(6);
+    pass.End();
+
+    if(frame < iFrameCount - 1)
+    {
+      auto commands = encoder.Finish();
+      device.GetQueue().Submit(1, &commands);
+    }
+    else
+    {
+      // the last frame is read back (which waits for every frame to be rendered)
+      readbackPool->submit(encoder, texture, iWidth, iHeight, [&checksum, iWidth, iHeight](std::uint8_t const *iData,
+                                                                                          std::uint32_t iBytesPerRow) {
+        std::uint64_t h = 14695981039346656037ull;
+        for(std::uint32_t y = 0; iData && y < iHeight; y++)
+        {
+          for(std::uint32_t x = 0; x < iWidth * 4; x++)
+            h = (h ^ iData[y * iBytesPerRow + x]) * 1099511628211ull;
+        }
+        checksum = h;
+      });
+    }
+  }
+
+  while(!checksum && !gpu->hasError())
+    gpu->pollEvents();
+
+  std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+
+  if(auto error = gpu->consumeError())
+  {
+    std::fprintf(stderr, "%s error | %s\n", gpu::GPU::errorTypeAsString(error->fType), error->fMessage.c_str());
+    return 1;
+  }
+
+  std::printf("%s\n", fmt::printf("frames: %d | size: %ux%u | total: %.3fms | per frame: %.3fms | checksum: %016llx",
+                                  iFrameCount, iWidth, iHeight,
+                                  duration.count(), duration.count() / iFrameCount,
+                                  static_cast<unsigned long long>(*checksum)).c_str());
+  return 0;
+}
+
+}
+
+//------------------------------------------------------------------------
+// main
+//------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  if(argc < 2)
+  {
+    std::fprintf(stderr, "Usage: %s <shader.wgsl> [width] [height] [frames]\n", argv[0]);
+    return 1;
+  }
+
+  auto code = shader_toy::headless::readFile(argv[1]);
+  if(!code)
+  {
+    std::fprintf(stderr, "Cannot read %s\n", argv[1]);
+    return 1;
+  }
+
+  auto width = argc > 2 ? std::stoul(argv[2]) : 1280ul;
+  auto height = argc > 3 ? std::stoul(argv[3]) : 720ul;
+  auto frames = argc > 4 ? std::stoi(argv[4]) : 60;
+
+  try
+  {
+    return shader_toy::headless::run(*code,
+                                     static_cast<std::uint32_t>(width),
+                                     static_cast<std::uint32_t>(height),
+                                     std::max(frames, 1));
+  }
+  catch(std::exception &e)
+  {
+    std::fprintf(stderr, "ABORT| Unrecoverable exception detected: %s\n", e.what());
+    return 1;
+  }
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+// Native implementation of the functions provided (in JavaScript) by src/js/lib_wgpu_shader_toy.js which are
+// required by the core library
+
+#include <cstdio>
+
+extern "C" {
+
+//------------------------------------------------------------------------
+// wgpu_shader_toy_abort
+//------------------------------------------------------------------------
+void wgpu_shader_toy_abort(char const *iMessage)
+{
+  std::fprintf(stderr, "%s\n", iMessage ? iMessage : "");
+}
+
+}
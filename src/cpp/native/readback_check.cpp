@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+// Checks of the readback pool (using a software adapter): in particular a readback reusing a (bigger) staging buffer
+// of a previous one (ex: the smaller edge tiles of a hi-res screenshot). Exits with a non zero status when a check
+// fails.
+//
+// Usage: wgpu_shader_toy_readback_check
+
+#include "gpu/GPU.h"
+#include "gpu/ReadbackPool.h"
+#include <cstdio>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+using namespace pongasoft;
+
+namespace shader_toy::readback_check {
+
+constexpr std::uint32_t kTextureWidth = 256;
+constexpr std::uint32_t kTextureHeight = 64;
+
+//------------------------------------------------------------------------
+// createGPU
+// Waits (processing events) until the device is created
+//------------------------------------------------------------------------
+std::shared_ptr<gpu::GPU> createGPU()
+{
+  std::shared_ptr<gpu::GPU> res{};
+  bool done = false;
+  auto gpu = gpu::GPU::asyncCreate([&res, &done](std::shared_ptr<gpu::GPU> iGPU) {
+                                     res = std::move(iGPU);
+                                     done = true;
+                                   },
+                                   [&done](wgpu::StringView iMessage) {
+                                     std::fprintf(stderr, "Cannot create GPU: %.*s\n",
+                                                  static_cast<int>(iMessage.length), iMessage.data);
+                                     done = true;
+                                   },
+                                   true);
+  while(!done)
+    gpu->pollEvents();
+  return res;
+}
+
+// value of the byte `i` (RGBA) of the pixel (x, y) of the texture
+constexpr std::uint8_t pixel(std::uint32_t x, std::uint32_t y, std::uint32_t i)
+{
+  return static_cast<std::uint8_t>(x * 4 + y * 7 + i);
+}
+
+//------------------------------------------------------------------------
+// readback
+// Reads back the (top left) `iWidth` x `iHeight` area of the texture and returns whether it matches its content
+//------------------------------------------------------------------------
+bool readback(gpu::GPU &iGPU,
+              gpu::ReadbackPool &iPool,
+              wgpu::Texture const &iTexture,
+              std::uint32_t iWidth,
+              std::uint32_t iHeight)
+{
+  std::optional<bool> res{};
+  iPool.submit(iGPU.getDevice().CreateCommandEncoder(), iTexture, iWidth, iHeight,
+               [&res, iWidth, iHeight](std::uint8_t const *iData, std::uint32_t iBytesPerRow) {
+                 res = iData != nullptr;
+                 for(std::uint32_t y = 0; *res && y < iHeight; y++)
+                 {
+                   for(std::uint32_t x = 0; *res && x < iWidth; x++)
+                   {
+                     for(std::uint32_t i = 0; i < 4; i++)
+                       *res = *res && iData[y * iBytesPerRow + x * 4 + i] == pixel(x, y, i);
+                   }
+                 }
+               });
+  while(!res && !iGPU.hasError())
+    iGPU.pollEvents();
+  return res.value_or(false);
+}
+
+}
+
+//------------------------------------------------------------------------
+// main
+//------------------------------------------------------------------------
+int main()
+{
+  using namespace shader_toy::readback_check;
+
+  auto gpu = createGPU();
+  if(!gpu)
+    return 1;
+
+  auto device = gpu->getDevice();
+
+  wgpu::TextureDescriptor textureDescriptor{
+    .label = "Readback Check | Texture",
+    .usage = wgpu::TextureUsage::CopyDst | wgpu::TextureUsage::CopySrc,
+    .size = {kTextureWidth, kTextureHeight, 1},
+    .format = wgpu::TextureFormat::RGBA8Unorm
+  };
+  auto texture = device.CreateTexture(&textureDescriptor);
+
+  std::vector<std::uint8_t> content(kTextureWidth * kTextureHeight * 4);
+  for(std::uint32_t y = 0; y < kTextureHeight; y++)
+  {
+    for(std::uint32_t x = 0; x < kTextureWidth; x++)
+    {
+      for(std::uint32_t i = 0; i < 4; i++)
+        content[(y * kTextureWidth + x) * 4 + i] = pixel(x, y, i);
+    }
+  }
+  wgpu::TexelCopyTextureInfo destination{.texture = texture};
+  wgpu::TexelCopyBufferLayout layout{.bytesPerRow = kTextureWidth * 4, .rowsPerImage = kTextureHeight};
+  wgpu::Extent3D extent{kTextureWidth, kTextureHeight, 1};
+  device.GetQueue().WriteTexture(&destination, content.data(), content.size(), &layout, &extent);
+
+  // a single staging buffer: the second readback reuses the (bigger) buffer of the first one
+  auto pool = std::make_shared<gpu::ReadbackPool>(device, 1);
+
+  int failures = 0;
+  if(!readback(*gpu, *pool, texture, kTextureWidth, kTextureHeight))
+  {
+    std::printf("FAILED [readback] full size\n");
+    failures++;
+  }
+  if(!readback(*gpu, *pool, texture, kTextureWidth / 4, kTextureHeight / 2))
+  {
+    std::printf("FAILED [readback] smaller size after a bigger one\n");
+    failures++;
+  }
+
+  if(auto error = gpu->consumeError())
+  {
+    std::fprintf(stderr, "%s error | %s\n", gpu::GPU::errorTypeAsString(error->fType), error->fMessage.c_str());
+    return 1;
+  }
+
+  if(failures > 0)
+    return 1;
+  std::printf("All checks passed\n");
+  return 0;
+}
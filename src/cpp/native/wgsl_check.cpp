@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+// Checks of the WGSL source analysis and transformations (which cannot be validated without a GPU device otherwise). Exits with
+// a non zero status when a check fails.
+//
+// Usage: wgpu_shader_toy_wgsl_check
+
+#include "State.h"
+#include "utils/WGSL.h"
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace pongasoft;
+
+namespace shader_toy {
+// defined in FragmentShaderExamples.cpp
+extern std::vector<Shader> kBuiltInFragmentShaderExamples;
+}
+
+namespace shader_toy::wgsl_check {
+
+int gFailures = 0;
+
+void check(bool iCondition, std::string_view iName, std::string_view iMessage)
+{
+  if(!iCondition)
+  {
+    std::printf("FAILED [%.*s] %.*s\n",
+                static_cast<int>(iName.size()), iName.data(),
+                static_cast<int>(iMessage.size()), iMessage.data());
+    gFailures++;
+  }
+}
+
+// the signature of the function `iFunction` (from `fn` to the opening brace of its body)
+std::string_view findSignature(std::string_view iSource, std::string_view iFunction)
+{
+  auto start = iSource.find("fn " + std::string(iFunction));
+  if(start == std::string_view::npos)
+    return {};
+  auto end = iSource.find('{', start);
+  return iSource.substr(start, end == std::string_view::npos ? end : end - start);
+}
+
+void checkDemoteFragmentEntryPoint(std::string_view iName, std::string_view iCode)
+{
+  auto code = utils::wgsl::demoteFragmentEntryPoint(iCode, "fragmentMain");
+  check(code.has_value(), iName, "fragmentMain entry point not found");
+  if(!code)
+    return;
+  check(code->size() == iCode.size(), iName, "line/column numbers not preserved");
+  check(code->find("@fragment") == std::string::npos, iName, "@fragment not removed");
+  auto signature = findSignature(*code, "fragmentMain");
+  check(!signature.empty(), iName, "fragmentMain signature not found");
+  check(signature.find('@') == std::string_view::npos, iName, "@builtin/@location left on fragmentMain");
+}
+
+void checkNormalizedHash()
+{
+  auto hash = [](std::string_view iSource) { return utils::wgsl::computeNormalizedHash(iSource); };
+  check(hash("x = 1e-3;") != hash("x = 1e - 3;"), "computeNormalizedHash", "exponent sign split from the literal");
+  check(hash("x = 0x1p+4;") != hash("x = 0x1p + 4;"), "computeNormalizedHash", "hex exponent sign split from the literal");
+  check(hash("x = 0x1e-3;") == hash("x = 0x1e - 3;"), "computeNormalizedHash", "hex digit e is not an exponent");
+  check(hash("x = 1e-3; // comment") == hash("x  =  1e-3;"), "computeNormalizedHash", "whitespace/comments not ignored");
+}
+
+void checkFindOverrides()
+{
+  auto overrides = utils::wgsl::findOverrides(R"(
+override speed: f32 = -1.5;
+@id(3) override count = 4u;
+override scale: f32 = speed * 2.0;
+override epsilon: f32 = 1e-3;
+override gain = -2.5e+1f;
+)");
+  check(overrides.size() == 5, "findOverrides", "5 overrides expected");
+  if(overrides.size() != 5)
+    return;
+  check(overrides[0].fDefaultValue == -1.5, "findOverrides", "negated literal not parsed");
+  check(overrides[1].fType == "u32" && overrides[1].fDefaultValue == 4.0 && overrides[1].fConstantKey == "3",
+        "findOverrides", "literal with id not parsed");
+  check(overrides[2].hasExpressionDefault(), "findOverrides", "expression default not detected");
+  check(overrides[3].fDefaultValue == 1e-3, "findOverrides", "exponent literal not parsed");
+  check(overrides[4].fType == "f32" && overrides[4].fDefaultValue == -25.0,
+        "findOverrides", "negated exponent literal not parsed");
+}
+
+}
+
+int main()
+{
+  using namespace shader_toy;
+  using namespace shader_toy::wgsl_check;
+
+  for(auto const &shader: kBuiltInFragmentShaderExamples)
+    checkDemoteFragmentEntryPoint(shader.fName, shader.fCode);
+
+  checkDemoteFragmentEntryPoint("attributes", R"(
+@fragment
+fn fragmentMain(@builtin(position) pos: vec4f,
+                @location(1) @interpolate(flat) v: u32) -> @location(0) @invariant vec4f {
+  return vec4f(pos.xy, 0, 1);
+}
+)");
+
+  checkNormalizedHash();
+  checkFindOverrides();
+
+  check(!utils::wgsl::demoteFragmentEntryPoint("fn fragmentMain() {}", "fragmentMain"), "no entry point",
+        "a function without @fragment is not an entry point");
+
+  if(gFailures > 0)
+    return 1;
+  std::printf("All checks passed\n");
+  return 0;
+}
@@ -18,6 +18,7 @@
 
 #include "DataManager.h"
 #include "../Errors.h"
+#include <cstring>
 
 namespace pongasoft::utils {
 
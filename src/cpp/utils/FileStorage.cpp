@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include "Storage.h"
+#include <fstream>
+#include <sstream>
+
+namespace pongasoft::utils {
+
+//------------------------------------------------------------------------
+// FileStorage::computePath
+//------------------------------------------------------------------------
+std::filesystem::path FileStorage::computePath(std::string_view iKey) const
+{
+  // keys (ex: "shader_toy::State") are not necessarily valid filenames
+  std::string filename{iKey};
+  for(auto &c: filename)
+  {
+    if(!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '.' || c == '-'))
+      c = '_';
+  }
+  return fDirectory / filename;
+}
+
+//------------------------------------------------------------------------
+// FileStorage::getItem
+//------------------------------------------------------------------------
+std::optional<std::string> FileStorage::getItem(std::string_view iKey)
+{
+  std::ifstream file{computePath(iKey), std::ios::binary};
+  if(!file)
+    return std::nullopt;
+  std::ostringstream content{};
+  content << file.rdbuf();
+  return content.str();
+}
+
+//------------------------------------------------------------------------
+// FileStorage::setItem
+//------------------------------------------------------------------------
+void FileStorage::setItem(std::string_view iKey, std::string_view iValue)
+{
+  std::filesystem::create_directories(fDirectory);
+  std::ofstream file{computePath(iKey), std::ios::binary | std::ios::trunc};
+  file.write(iValue.data(), static_cast<std::streamsize>(iValue.size()));
+}
+
+}
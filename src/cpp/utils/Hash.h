@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#ifndef WGPU_SHADER_TOY_UTILS_HASH_H
+#define WGPU_SHADER_TOY_UTILS_HASH_H
+
+#include <cstdint>
+#include <string_view>
+
+namespace pongasoft::utils::hash {
+
+using hash_t = std::uint64_t;
+
+constexpr hash_t kFNV1aOffsetBasis = 0xcbf29ce484222325ULL;
+constexpr hash_t kFNV1aPrime = 0x100000001b3ULL;
+
+//------------------------------------------------------------------------
+// hash::fnv1a
+// 64-bit FNV-1a hash. Can be chained by passing the result of a previous call as `iSeed`
+//------------------------------------------------------------------------
+constexpr hash_t fnv1a(std::string_view iData, hash_t iSeed = kFNV1aOffsetBasis)
+{
+  auto h = iSeed;
+  for(auto c: iData)
+  {
+    h ^= static_cast<unsigned char>(c);
+    h *= kFNV1aPrime;
+  }
+  return h;
+}
+
+//------------------------------------------------------------------------
+// hash::combine
+//------------------------------------------------------------------------
+constexpr hash_t combine(hash_t iHash, std::uint64_t iValue)
+{
+  for(int i = 0; i < 8; i++)
+  {
+    iHash ^= (iValue >> (i * 8)) & 0xff;
+    iHash *= kFNV1aPrime;
+  }
+  return iHash;
+}
+
+}
+
+#endif //WGPU_SHADER_TOY_UTILS_HASH_H
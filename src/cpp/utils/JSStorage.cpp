@@ -17,6 +17,7 @@
  */
 
 #include "Storage.h"
+#include "Trace.h"
 #include <emscripten.h>
 #include <vector>
 
@@ -45,6 +46,8 @@ namespace pongasoft::utils {
 //------------------------------------------------------------------------
 std::optional<std::string> JSStorage::getItem(std::string_view iKey)
 {
+  trace::Span span{"JSStorage::getItem", "io", iKey};
+
   // ok because in single threaded environment (otherwise could use thread_local)
   static std::vector<char> kBuffer(1024);
   auto size = jsLocalStorageGetItem(iKey.data(), kBuffer.data(), kBuffer.size());
@@ -65,6 +68,7 @@ std::optional<std::string> JSStorage::getItem(std::string_view iKey)
 //------------------------------------------------------------------------
 void JSStorage::setItem(std::string_view iKey, std::string_view iValue)
 {
+  trace::Span span{"JSStorage::setItem", "io", iKey};
   jsLocalStorageSetItem(iKey.data(), iValue.data());
 }
 
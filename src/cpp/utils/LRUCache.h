@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#ifndef WGPU_SHADER_TOY_UTILS_LRU_CACHE_H
+#define WGPU_SHADER_TOY_UTILS_LRU_CACHE_H
+
+#include <list>
+#include <unordered_map>
+#include <cstddef>
+
+namespace pongasoft::utils {
+
+/**
+ * Least recently used cache bounded by a budget. Each entry has a cost (for example its size in bytes) and the least
+ * recently used entries are evicted as soon as the total cost exceeds the budget. */
+template<typename K, typename V, typename Hash = std::hash<K>>
+class LRUCache
+{
+public:
+  explicit LRUCache(std::size_t iBudget) : fBudget{iBudget} {}
+
+  // returns `nullptr` when not found (a successful lookup makes the entry the most recently used)
+  V const *find(K const &iKey);
+  void put(K const &iKey, V iValue, std::size_t iCost);
+  void erase(K const &iKey);
+  void clear();
+
+  void setBudget(std::size_t iBudget) { fBudget = iBudget; evict(); }
+  constexpr std::size_t getBudget() const { return fBudget; }
+  constexpr std::size_t getCost() const { return fCost; }
+  inline std::size_t getSize() const { return fEntries.size(); }
+  constexpr std::size_t getHitCount() const { return fHitCount; }
+  constexpr std::size_t getMissCount() const { return fMissCount; }
+
+private:
+  struct Entry
+  {
+    K fKey;
+    V fValue;
+    std::size_t fCost;
+  };
+
+  void evict();
+
+private:
+  std::size_t fBudget;
+  std::size_t fCost{};
+  std::size_t fHitCount{};
+  std::size_t fMissCount{};
+  std::list<Entry> fEntries{}; // front is the most recently used
+  std::unordered_map<K, typename std::list<Entry>::iterator, Hash> fIndex{};
+};
+
+//------------------------------------------------------------------------
+// LRUCache::find
+//------------------------------------------------------------------------
+template<typename K, typename V, typename Hash>
+V const *LRUCache<K, V, Hash>::find(K const &iKey)
+{
+  auto iter = fIndex.find(iKey);
+  if(iter == fIndex.end())
+  {
+    fMissCount++;
+    return nullptr;
+  }
+  fHitCount++;
+  fEntries.splice(fEntries.begin(), fEntries, iter->second);
+  return &iter->second->fValue;
+}
+
+//------------------------------------------------------------------------
+// LRUCache::put
+//------------------------------------------------------------------------
+template<typename K, typename V, typename Hash>
+void LRUCache<K, V, Hash>::put(K const &iKey, V iValue, std::size_t iCost)
+{
+  erase(iKey);
+  if(iCost > fBudget)
+    return;
+  fEntries.emplace_front(Entry{iKey, std::move(iValue), iCost});
+  fIndex[iKey] = fEntries.begin();
+  fCost += iCost;
+  evict();
+}
+
+//------------------------------------------------------------------------
+// LRUCache::erase
+//------------------------------------------------------------------------
+template<typename K, typename V, typename Hash>
+void LRUCache<K, V, Hash>::erase(K const &iKey)
+{
+  auto iter = fIndex.find(iKey);
+  if(iter != fIndex.end())
+  {
+    fCost -= iter->second->fCost;
+    fEntries.erase(iter->second);
+    fIndex.erase(iter);
+  }
+}
+
+//------------------------------------------------------------------------
+// LRUCache::clear
+//------------------------------------------------------------------------
+template<typename K, typename V, typename Hash>
+void LRUCache<K, V, Hash>::clear()
+{
+  fEntries.clear();
+  fIndex.clear();
+  fCost = 0;
+}
+
+//------------------------------------------------------------------------
+// LRUCache::evict
+//------------------------------------------------------------------------
+template<typename K, typename V, typename Hash>
+void LRUCache<K, V, Hash>::evict()
+{
+  while(fCost > fBudget && !fEntries.empty())
+  {
+    auto &entry = fEntries.back();
+    fCost -= entry.fCost;
+    fIndex.erase(entry.fKey);
+    fEntries.pop_back();
+  }
+}
+
+}
+
+#endif //WGPU_SHADER_TOY_UTILS_LRU_CACHE_H
@@ -21,6 +21,7 @@
 
 #include <string>
 #include <optional>
+#include <filesystem>
 
 namespace pongasoft::utils {
 
@@ -45,6 +46,22 @@ public:
   void setItem(std::string_view iKey, std::string_view iValue) override;
 };
 
+/**
+ * Native (non Emscripten) storage: each item is stored in its own file (in `iDirectory`) */
+class FileStorage : public Storage
+{
+public:
+  explicit FileStorage(std::filesystem::path iDirectory) : fDirectory{std::move(iDirectory)} {}
+  std::optional<std::string> getItem(std::string_view iKey) override;
+  void setItem(std::string_view iKey, std::string_view iValue) override;
+
+private:
+  std::filesystem::path computePath(std::string_view iKey) const;
+
+private:
+  std::filesystem::path fDirectory;
+};
+
 }
 
 
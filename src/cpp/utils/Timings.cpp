@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include "Timings.h"
+#include <algorithm>
+
+namespace pongasoft::utils {
+
+//------------------------------------------------------------------------
+// TimingHistory::add
+//------------------------------------------------------------------------
+void TimingHistory::add(double iDurationMs)
+{
+  if(fDurations.empty())
+    return;
+  fDurations[fNext] = iDurationMs;
+  fNext = (fNext + 1) % fDurations.size();
+  fCount = std::min(fCount + 1, fDurations.size());
+}
+
+//------------------------------------------------------------------------
+// TimingHistory::computeSummary
+//------------------------------------------------------------------------
+TimingHistory::Summary TimingHistory::computeSummary() const
+{
+  if(fCount == 0)
+    return {};
+
+  // the most recent duration is right before the next slot
+  auto last = fDurations[(fNext + fDurations.size() - 1) % fDurations.size()];
+
+  // the ring buffer is only partially filled until it wraps around (starting at 0)
+  std::vector<double> durations(fDurations.begin(), fDurations.begin() + static_cast<std::ptrdiff_t>(fCount));
+  std::ranges::sort(durations);
+
+  double total{};
+  for(auto d: durations)
+    total += d;
+
+  auto percentile = [&durations](double p) {
+    return durations[std::min(durations.size() - 1, static_cast<std::size_t>(p * static_cast<double>(durations.size())))];
+  };
+
+  return {
+    .fCount = fCount,
+    .fLast = last,
+    .fMin = durations.front(),
+    .fAvg = total / static_cast<double>(fCount),
+    .fP95 = percentile(0.95),
+    .fP99 = percentile(0.99)
+  };
+}
+
+//------------------------------------------------------------------------
+// PhaseTimings::record
+//------------------------------------------------------------------------
+void PhaseTimings::record(std::string_view iPhase, double iDurationMs)
+{
+  auto phase = std::ranges::find_if(fPhases, [iPhase](auto const &p) { return p.first == iPhase; });
+  if(phase == fPhases.end())
+  {
+    fPhases.emplace_back(std::string{iPhase}, TimingHistory{});
+    phase = std::prev(fPhases.end());
+  }
+  phase->second.add(iDurationMs);
+}
+
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#ifndef WGPU_SHADER_TOY_UTILS_TIMINGS_H
+#define WGPU_SHADER_TOY_UTILS_TIMINGS_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Trace.h"
+
+namespace pongasoft::utils {
+
+/**
+ * Keeps the last N durations (in milliseconds) of a phase in a ring buffer: adding a duration is cheap (no allocation)
+ * and the summary is only computed on demand (for display) */
+class TimingHistory
+{
+public:
+  static constexpr std::size_t kDefaultCapacity = 240;
+
+  struct Summary
+  {
+    std::size_t fCount{};
+    double fLast{};
+    double fMin{};
+    double fAvg{};
+    double fP95{};
+    double fP99{};
+  };
+
+public:
+  explicit TimingHistory(std::size_t iCapacity = kDefaultCapacity) : fDurations(iCapacity) {}
+
+  void add(double iDurationMs);
+  Summary computeSummary() const;
+  void clear() { fNext = 0; fCount = 0; }
+
+  constexpr std::size_t getCount() const { return fCount; }
+
+private:
+  std::vector<double> fDurations;
+  std::size_t fNext{};
+  std::size_t fCount{};
+};
+
+/**
+ * Timings of the phases of a frame, each phase having its own history. The phases are kept in the order in which
+ * they were first recorded (there are only a handful of them, so a lookup is a linear search). Each measure is also
+ * traced as a span (`trace::Tracer::instance()`) whose category is the name of the timings.
+ *
+ * ```
+ * {
+ *   auto timing = timings.measure("beforeFrame"); // recorded when `timing` goes out of scope
+ *   beforeFrame();
+ * }
+ * ``` */
+class PhaseTimings
+{
+public:
+  class Measure
+  {
+  public:
+    Measure(PhaseTimings &iTimings, std::string_view iPhase) :
+      fTimings{iTimings}, fPhase{iPhase}, fStartTime{trace::Tracer::instance().now()} {}
+    ~Measure()
+    {
+      auto &tracer = trace::Tracer::instance();
+      fTimings.record(fPhase, (tracer.now() - fStartTime) / 1000.0);
+      tracer.complete(fPhase, fTimings.getName(), fStartTime);
+    }
+    Measure(Measure const &) = delete;
+    Measure &operator=(Measure const &) = delete;
+
+  private:
+    PhaseTimings &fTimings;
+    std::string_view fPhase;
+    double fStartTime; // in microseconds
+  };
+
+  using phases_t = std::vector<std::pair<std::string, TimingHistory>>;
+
+public:
+  explicit PhaseTimings(std::string iName = {}) : fName{std::move(iName)} {}
+
+  std::string const &getName() const { return fName; }
+  void setName(std::string iName) { fName = std::move(iName); }
+
+  // iPhase must outlive the measure (typically a string literal)
+  [[nodiscard]] Measure measure(std::string_view iPhase) { return {*this, iPhase}; }
+  void record(std::string_view iPhase, double iDurationMs);
+
+  phases_t const &getPhases() const { return fPhases; }
+  void clear() { fPhases.clear(); }
+
+private:
+  std::string fName;
+  phases_t fPhases{};
+};
+
+}
+
+#endif //WGPU_SHADER_TOY_UTILS_TIMINGS_H
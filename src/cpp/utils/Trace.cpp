@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include "Trace.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+
+using json = nlohmann::json;
+
+namespace pongasoft::utils::trace {
+
+//------------------------------------------------------------------------
+// Tracer::Tracer
+//------------------------------------------------------------------------
+Tracer::Tracer(std::size_t iCapacity) : fEvents(std::max<std::size_t>(iCapacity, 1))
+{
+}
+
+//------------------------------------------------------------------------
+// Tracer::instance
+//------------------------------------------------------------------------
+Tracer &Tracer::instance()
+{
+  static Tracer kTracer{};
+  return kTracer;
+}
+
+//------------------------------------------------------------------------
+// Tracer::nextEvent
+// The event is reused (its strings keep their capacity so that recording does not allocate once the buffer is full)
+//------------------------------------------------------------------------
+Event &Tracer::nextEvent()
+{
+  auto &event = fEvents[fNext];
+  fNext = (fNext + 1) % fEvents.size();
+  fCount = std::min(fCount + 1, fEvents.size());
+  return event;
+}
+
+//------------------------------------------------------------------------
+// Tracer::add
+//------------------------------------------------------------------------
+void Tracer::add(Event::Phase iPhase,
+                 std::string_view iName,
+                 std::string_view iCategory,
+                 std::string_view iDetail,
+                 double iTimestamp,
+                 double iDuration,
+                 id_t iId)
+{
+  auto &event = nextEvent();
+  event.fName.assign(iName);
+  event.fCategory.assign(iCategory);
+  event.fDetail.assign(iDetail);
+  event.fPhase = iPhase;
+  event.fTimestamp = iTimestamp;
+  event.fDuration = iDuration;
+  event.fId = iId;
+}
+
+//------------------------------------------------------------------------
+// Tracer::complete
+//------------------------------------------------------------------------
+void Tracer::complete(std::string_view iName, std::string_view iCategory, double iStartTime, std::string_view iDetail)
+{
+  if(fEnabled)
+    add(Event::Phase::kComplete, iName, iCategory, iDetail, iStartTime, now() - iStartTime, 0);
+}
+
+//------------------------------------------------------------------------
+// Tracer::beginAsync
+//------------------------------------------------------------------------
+id_t Tracer::beginAsync(std::string_view iName, std::string_view iCategory, std::string_view iDetail)
+{
+  if(!fEnabled)
+    return 0;
+  auto id = ++fLastId;
+  add(Event::Phase::kAsyncBegin, iName, iCategory, iDetail, now(), 0, id);
+  return id;
+}
+
+//------------------------------------------------------------------------
+// Tracer::endAsync
+//------------------------------------------------------------------------
+void Tracer::endAsync(id_t iId, std::string_view iName, std::string_view iCategory, std::string_view iDetail)
+{
+  // the span began while tracing was disabled
+  if(fEnabled && iId != 0)
+    add(Event::Phase::kAsyncEnd, iName, iCategory, iDetail, now(), 0, iId);
+}
+
+//------------------------------------------------------------------------
+// Tracer::exportChromeTrace
+//------------------------------------------------------------------------
+std::string Tracer::exportChromeTrace() const
+{
+  auto events = json::array();
+
+  events.push_back({
+                     {"name", "process_name"},
+                     {"ph",   "M"},
+                     {"pid",  1},
+                     {"args", {{"name", "WebGPU Shader Toy"}}}
+                   });
+
+  // the oldest event is the next one to be overwritten (once the buffer is full)
+  auto const first = (fNext + fEvents.size() - fCount) % fEvents.size();
+  for(std::size_t i = 0; i < fCount; i++)
+  {
+    auto const &event = fEvents[(first + i) % fEvents.size()];
+    json e{
+      {"name", event.fName},
+      {"cat",  event.fCategory},
+      {"ph",   std::string(1, static_cast<char>(event.fPhase))},
+      {"ts",   event.fTimestamp},
+      {"pid",  1},
+      {"tid",  1}
+    };
+    if(event.fPhase == Event::Phase::kComplete)
+      e["dur"] = event.fDuration;
+    else
+      e["id"] = event.fId;
+    if(!event.fDetail.empty())
+      e["args"] = {{"detail", event.fDetail}};
+    events.emplace_back(std::move(e));
+  }
+
+  return json{
+    {"traceEvents",     std::move(events)},
+    {"displayTimeUnit", "ms"}
+  }.dump();
+}
+
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#ifndef WGPU_SHADER_TOY_UTILS_TRACE_H
+#define WGPU_SHADER_TOY_UTILS_TRACE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pongasoft::utils::trace {
+
+using id_t = std::uint64_t;
+
+struct Event
+{
+  // the values are the ones used by the Chrome trace-event format
+  enum class Phase : char
+  {
+    kComplete = 'X',
+    kAsyncBegin = 'b',
+    kAsyncEnd = 'e'
+  };
+
+  std::string fName{};
+  std::string fCategory{};
+  std::string fDetail{};
+  Phase fPhase{Phase::kComplete};
+  double fTimestamp{}; // in microseconds (since the tracer was created)
+  double fDuration{};  // in microseconds (kComplete only)
+  id_t fId{};          // matches the beginning and the end of an asynchronous span
+};
+
+/**
+ * Records spans in a ring buffer (the oldest events are overwritten so that tracing can always be on) and exports
+ * them in the Chrome trace-event format (which can be loaded in Perfetto or chrome://tracing).
+ *
+ * - synchronous spans (a scope, see `Span`) are recorded as one complete event when they end
+ * - asynchronous spans (ex: from a request to its result) are recorded as a begin event and an end event sharing the
+ *   id returned by `beginAsync` */
+class Tracer
+{
+public:
+  using clock_t = std::chrono::steady_clock;
+
+  static constexpr std::size_t kDefaultCapacity = 32768;
+
+public:
+  explicit Tracer(std::size_t iCapacity = kDefaultCapacity);
+
+  // the tracer used by the application
+  static Tracer &instance();
+
+  constexpr bool isEnabled() const { return fEnabled; }
+  constexpr void setEnabled(bool iEnabled) { fEnabled = iEnabled; }
+
+  // time (in microseconds) since the tracer was created
+  double now() const { return std::chrono::duration<double, std::micro>(clock_t::now() - fStartTime).count(); }
+
+  void complete(std::string_view iName, std::string_view iCategory, double iStartTime, std::string_view iDetail = {});
+  // returns the id to provide to `endAsync` (0 when not enabled)
+  id_t beginAsync(std::string_view iName, std::string_view iCategory, std::string_view iDetail = {});
+  void endAsync(id_t iId, std::string_view iName, std::string_view iCategory, std::string_view iDetail = {});
+
+  constexpr std::size_t getEventCount() const { return fCount; }
+  void clear() { fNext = 0; fCount = 0; }
+
+  // the events (oldest first) in the Chrome trace-event (JSON) format
+  std::string exportChromeTrace() const;
+
+private:
+  Event &nextEvent();
+  void add(Event::Phase iPhase,
+           std::string_view iName,
+           std::string_view iCategory,
+           std::string_view iDetail,
+           double iTimestamp,
+           double iDuration,
+           id_t iId);
+
+private:
+  clock_t::time_point fStartTime{clock_t::now()};
+  bool fEnabled{true};
+  std::vector<Event> fEvents;
+  std::size_t fNext{};
+  std::size_t fCount{};
+  id_t fLastId{};
+};
+
+/**
+ * Records the scope it lives in as a complete event (in `Tracer::instance()`). Note that the strings are not copied
+ * until the span ends: they must outlive it. */
+class Span
+{
+public:
+  Span(std::string_view iName, std::string_view iCategory, std::string_view iDetail = {}) :
+    fName{iName}, fCategory{iCategory}, fDetail{iDetail}, fStartTime{Tracer::instance().now()} {}
+  ~Span() { Tracer::instance().complete(fName, fCategory, fStartTime, fDetail); }
+  Span(Span const &) = delete;
+  Span &operator=(Span const &) = delete;
+
+private:
+  std::string_view fName;
+  std::string_view fCategory;
+  std::string_view fDetail;
+  double fStartTime;
+};
+
+}
+
+#endif //WGPU_SHADER_TOY_UTILS_TRACE_H
@@ -23,6 +23,8 @@
 #include <functional>
 #include <vector>
 #include <concepts>
+#include <memory>
+#include <optional>
 
 namespace pongasoft::utils {
 
@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#include "WGSL.h"
+#include <charconv>
+
+namespace pongasoft::utils::wgsl {
+
+namespace impl {
+
+//------------------------------------------------------------------------
+// impl::isWhiteSpace
+//------------------------------------------------------------------------
+constexpr bool isWhiteSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+//------------------------------------------------------------------------
+// impl::isWordCharacter
+// Note that non ASCII characters (utf-8 identifiers) are treated as part of a word
+//------------------------------------------------------------------------
+constexpr bool isWordCharacter(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '.' ||
+         static_cast<unsigned char>(c) >= 0x80;
+}
+
+//------------------------------------------------------------------------
+// impl::isDigit
+//------------------------------------------------------------------------
+constexpr bool isDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+//------------------------------------------------------------------------
+// impl::kOperators
+// Multi characters WGSL operators (longest first)
+//------------------------------------------------------------------------
+constexpr std::string_view kOperators[] = {
+  "<<=", ">>=",
+  "&&", "||", "--", "++", "->", "<<", ">>", "<=", ">=", "==", "!=", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^="
+};
+
+}
+
+//------------------------------------------------------------------------
+// Tokenizer::skipWhiteSpaceAndComments
+//------------------------------------------------------------------------
+void Tokenizer::skipWhiteSpaceAndComments()
+{
+  while(fPosition < fSource.size())
+  {
+    if(impl::isWhiteSpace(fSource[fPosition]))
+    {
+      fPosition++;
+    }
+    else if(fSource.substr(fPosition, 2) == "//")
+    {
+      auto end = fSource.find('\n', fPosition);
+      fPosition = end == std::string_view::npos ? fSource.size() : end + 1;
+    }
+    else if(fSource.substr(fPosition, 2) == "/*")
+    {
+      // block comments can be nested in WGSL
+      int depth = 0;
+      while(fPosition < fSource.size())
+      {
+        auto s = fSource.substr(fPosition, 2);
+        if(s == "/*")
+        {
+          depth++;
+          fPosition += 2;
+        }
+        else if(s == "*/")
+        {
+          fPosition += 2;
+          if(--depth == 0)
+            break;
+        }
+        else
+          fPosition++;
+      }
+    }
+    else
+      break;
+  }
+}
+
+//------------------------------------------------------------------------
+// Tokenizer::next
+//------------------------------------------------------------------------
+std::optional<std::string_view> Tokenizer::next()
+{
+  skipWhiteSpaceAndComments();
+
+  if(fPosition >= fSource.size())
+    return std::nullopt;
+
+  auto start = fPosition;
+  if(impl::isWordCharacter(fSource[fPosition]))
+  {
+    // the sign of the exponent is part of a numeric literal (`1e-3` is not `1e - 3`, `0x1p+4` is not `0x1p + 4`)
+    auto isNumber = impl::isDigit(fSource[start]) ||
+                    (fSource[start] == '.' && start + 1 < fSource.size() && impl::isDigit(fSource[start + 1]));
+    auto isHex = isNumber && (fSource.substr(start, 2) == "0x" || fSource.substr(start, 2) == "0X");
+    auto exponent = std::string_view{isHex ? "pP" : "eE"};
+    while(fPosition < fSource.size())
+    {
+      auto c = fSource[fPosition];
+      if(impl::isWordCharacter(c))
+        fPosition++;
+      else if(isNumber && (c == '+' || c == '-') && exponent.contains(fSource[fPosition - 1]))
+        fPosition++;
+      else
+        break;
+    }
+  }
+  else
+  {
+    fPosition++;
+    for(auto op: impl::kOperators)
+    {
+      if(fSource.substr(start, op.size()) == op)
+      {
+        fPosition = start + op.size();
+        break;
+      }
+    }
+  }
+  return fSource.substr(start, fPosition - start);
+}
+
+//------------------------------------------------------------------------
+// computeNormalizedHash
+//------------------------------------------------------------------------
+hash::hash_t computeNormalizedHash(std::string_view iSource)
+{
+  Tokenizer tokenizer{iSource};
+  auto h = hash::kFNV1aOffsetBasis;
+  while(auto token = tokenizer.next())
+  {
+    h = hash::fnv1a(*token, h);
+    // separator so that tokens "ab" and "a", "b" do not produce the same hash
+    h = hash::fnv1a({"\0", 1}, h);
+  }
+  return h;
+}
+
+namespace impl {
+
+//------------------------------------------------------------------------
+// impl::parseLiteral
+// Returns the value (and type) of a WGSL literal (`true`, `1`, `2u`, `1.5`, `3e2f`, `0x1F`...)
+//------------------------------------------------------------------------
+std::optional<std::pair<double, char const *>> parseLiteral(std::string_view iLiteral)
+{
+  if(iLiteral == "true")
+    return std::pair{1.0, "bool"};
+  if(iLiteral == "false")
+    return std::pair{0.0, "bool"};
+
+  char const *type = "i32";
+  auto isHex = iLiteral.starts_with("0x") || iLiteral.starts_with("0X");
+  if(iLiteral.ends_with('u'))
+  {
+    type = "u32";
+    iLiteral.remove_suffix(1);
+  }
+  else if(iLiteral.ends_with('i'))
+  {
+    iLiteral.remove_suffix(1);
+  }
+  else if(!isHex && (iLiteral.ends_with('f') || iLiteral.ends_with('h')))
+  {
+    type = iLiteral.ends_with('f') ? "f32" : "f16";
+    iLiteral.remove_suffix(1);
+  }
+
+  if(!isHex && iLiteral.find_first_of(".eE") != std::string_view::npos)
+    type = std::string_view{type} == "f16" ? "f16" : "f32";
+
+  double value{};
+  std::from_chars_result res{};
+  if(isHex)
+  {
+    long long v{};
+    res = std::from_chars(iLiteral.data() + 2, iLiteral.data() + iLiteral.size(), v, 16);
+    value = static_cast<double>(v);
+  }
+  else
+    res = std::from_chars(iLiteral.data(), iLiteral.data() + iLiteral.size(), value);
+
+  if(res.ec != std::errc{} || res.ptr != iLiteral.data() + iLiteral.size())
+    return std::nullopt;
+
+  return std::pair{value, type};
+}
+
+}
+
+//------------------------------------------------------------------------
+// findOverrides
+//------------------------------------------------------------------------
+std::vector<Override> findOverrides(std::string_view iSource)
+{
+  std::vector<Override> res{};
+
+  Tokenizer tokenizer{iSource};
+  std::optional<std::uint32_t> id{};
+  while(auto token = tokenizer.next())
+  {
+    // @id(n)
+    if(*token == "@")
+    {
+      if(tokenizer.next() == "id" && tokenizer.next() == "(")
+      {
+        if(auto idToken = tokenizer.next())
+        {
+          if(auto literal = impl::parseLiteral(*idToken); literal && tokenizer.next() == ")")
+            id = static_cast<std::uint32_t>(literal->first);
+        }
+      }
+      continue;
+    }
+
+    if(*token != "override")
+    {
+      id = std::nullopt;
+      continue;
+    }
+
+    auto name = tokenizer.next();
+    if(!name)
+      break;
+
+    Override o{.fName = std::string(*name), .fId = id};
+    id = std::nullopt;
+
+    token = tokenizer.next();
+    if(token == ":")
+    {
+      if(auto type = tokenizer.next())
+        o.fType = *type;
+      token = tokenizer.next();
+    }
+
+    if(token == "=")
+    {
+      std::string initializer{};
+      std::vector<std::string_view> tokens{};
+      while((token = tokenizer.next()) && *token != ";")
+      {
+        if(!tokens.empty())
+          initializer += " ";
+        initializer += *token;
+        tokens.emplace_back(*token);
+      }
+      // a literal, optionally negated (ex: `-1.5`)
+      auto negated = tokens.size() == 2 && tokens[0] == "-";
+      if(tokens.size() == 1 || negated)
+      {
+        if(auto literal = impl::parseLiteral(tokens.back()))
+        {
+          o.fDefaultValue = negated ? -literal->first : literal->first;
+          if(o.fType.empty())
+            o.fType = literal->second;
+        }
+      }
+      o.fInitializer = std::move(initializer);
+    }
+
+    if(o.fType.empty())
+      o.fType = "f32";
+
+    o.fConstantKey = o.fId ? std::to_string(*o.fId) : o.fName;
+
+    res.emplace_back(std::move(o));
+  }
+
+  return res;
+}
+
+//------------------------------------------------------------------------
+// demoteFragmentEntryPoint
+//------------------------------------------------------------------------
+std::optional<std::string> demoteFragmentEntryPoint(std::string_view iSource, std::string_view iEntryPoint)
+{
+  auto start = [iSource](std::string_view iToken) { return static_cast<std::size_t>(iToken.data() - iSource.data()); };
+  auto end = [iSource](std::string_view iToken) { return static_cast<std::size_t>(iToken.data() + iToken.size() - iSource.data()); };
+
+  // replaced with spaces so that line/column numbers do not change
+  std::string res{iSource};
+  auto blank = [&res](std::size_t iStart, std::size_t iEnd) { res.replace(iStart, iEnd - iStart, iEnd - iStart, ' '); };
+
+  Tokenizer tokenizer{iSource};
+  // the last `@fragment` attribute not yet followed by a function (empty when none)
+  std::string_view attribute{};
+  std::optional<std::string_view> previous{};
+  while(auto token = tokenizer.next())
+  {
+    if(*token == "fragment" && previous == "@")
+    {
+      attribute = iSource.substr(start(*previous), end(*token) - start(*previous));
+    }
+    else if(previous == "fn")
+    {
+      if(*token == iEntryPoint && !attribute.empty())
+      {
+        blank(start(attribute), end(attribute));
+
+        // the I/O attributes (`@builtin(...)`, `@location(...)`, ...) of the parameters and of the return type are
+        // only allowed on an entry point: they are removed up to the body of the function
+        while((token = tokenizer.next()) && *token != "{")
+        {
+          if(*token != "@")
+            continue;
+          auto attributeStart = start(*token);
+          auto attributeEnd = attributeStart;
+          if(auto name = tokenizer.next())
+          {
+            attributeEnd = end(*name);
+            // the arguments are optional (ex: `@invariant`)
+            auto lookahead = tokenizer;
+            if(lookahead.next() == "(")
+            {
+              int depth = 1;
+              while(depth > 0 && (token = lookahead.next()))
+              {
+                if(*token == "(")
+                  depth++;
+                else if(*token == ")")
+                  depth--;
+                attributeEnd = end(*token);
+              }
+              tokenizer = lookahead;
+            }
+          }
+          blank(attributeStart, attributeEnd);
+        }
+        return res;
+      }
+      attribute = {};
+    }
+    previous = token;
+  }
+  return std::nullopt;
+}
+
+}
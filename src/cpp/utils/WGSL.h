@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 pongasoft
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * @author Yan Pujante
+ */
+
+#ifndef WGPU_SHADER_TOY_UTILS_WGSL_H
+#define WGPU_SHADER_TOY_UTILS_WGSL_H
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Hash.h"
+
+namespace pongasoft::utils::wgsl {
+
+/**
+ * Lightweight WGSL tokenizer: it does not validate anything, it only splits the source into tokens, skipping
+ * whitespace and comments (line comments and nested block comments).
+ *
+ * - a token is either a word (identifier, keyword or number) or a punctuation token
+ * - punctuation uses the longest WGSL operator (maximal munch) so that `a - -b` and `a --b` do not produce the
+ *   same tokens */
+class Tokenizer
+{
+public:
+  explicit Tokenizer(std::string_view iSource) : fSource{iSource} {}
+
+  // returns the next token or `std::nullopt` when there is no more token
+  std::optional<std::string_view> next();
+
+private:
+  void skipWhiteSpaceAndComments();
+
+private:
+  std::string_view fSource;
+  std::size_t fPosition{};
+};
+
+/**
+ * Computes a hash of the tokens of the source: 2 sources which differ only by whitespace and/or comments produce
+ * the same hash */
+hash::hash_t computeNormalizedHash(std::string_view iSource);
+
+/**
+ * A pipeline-overridable constant (`[@id(n)] override name [: type] [= initializer];`) */
+struct Override
+{
+  std::string fName{};
+  std::string fType{};                      // f32, f16, i32, u32 or bool (inferred from the initializer when omitted)
+  std::optional<std::uint32_t> fId{};
+  std::optional<std::string> fInitializer{}; // initializer expression (normalized: tokens separated by a space)
+  std::optional<double> fDefaultValue{};    // value of the initializer when it is a (possibly negated) literal
+  std::string fConstantKey{};               // key in the pipeline constants (the id when there is one, the name otherwise)
+
+  constexpr bool isBool() const { return fType == "bool"; }
+  constexpr bool isInteger() const { return fType == "i32" || fType == "u32"; }
+  // the default value is an expression evaluated by the shader compiler (so it is unknown)
+  constexpr bool hasExpressionDefault() const { return fInitializer && !fDefaultValue; }
+};
+
+/**
+ * Finds all the `override` declarations in the source */
+std::vector<Override> findOverrides(std::string_view iSource);
+
+/**
+ * Demotes the fragment entry point `iEntryPoint` to a regular function which can be called by another entry point:
+ * the `@fragment` attribute is removed as well as the I/O attributes (`@builtin`, `@location`, `@interpolate`, ...)
+ * of its parameters and return type (they are only allowed on entry points). The attributes are replaced with spaces
+ * so that line/column numbers are preserved. Returns `std::nullopt` when there is no such entry point. */
+std::optional<std::string> demoteFragmentEntryPoint(std::string_view iSource, std::string_view iEntryPoint);
+
+}
+
+#endif //WGPU_SHADER_TOY_UTILS_WGSL_H
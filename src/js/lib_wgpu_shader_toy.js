@@ -26,6 +26,7 @@ let wgpu_shader_toy = {
     fNewContentHandler: null, // <fn(userData, token, name, content, error)>
     fBeforeUnloadHandler: null, // <fn(userData)>
     fOnFileHandler: null, // <fn(userData, file)>
+    fScreenshotCanvas: null, // <OffscreenCanvas> (hi-res screenshot being stitched)
 
     // onNewContent
     onNewContent: (iToken, iName, iContent, iError) => {
@@ -65,6 +66,18 @@ let wgpu_shader_toy = {
       };
       reader.readAsText(file);
     },
+
+    // downloadBlob
+    downloadBlob: (iFilename, iBlob) => {
+      let url = URL.createObjectURL(iBlob);
+      let a = document.createElement('a');
+      document.body.append(a);
+      a.download = iFilename;
+      a.href = url;
+      a.click();
+      a.remove();
+      URL.revokeObjectURL(url);
+    },
   },
 
   // wgpu_shader_toy_install_handlers
@@ -172,16 +185,72 @@ let wgpu_shader_toy = {
     type = type ? UTF8ToString(type) : 'image/png';
     const canvas = Module.glfwGetCanvas(glfwWindow);
     if(canvas) {
-      canvas.toBlob((blob) => {
-        let url = URL.createObjectURL(blob);
-        let a = document.createElement('a');
-        document.body.append(a);
-        a.download = filename;
-        a.href = url;
-        a.click();
-        a.remove();
-      }, type, quality);
+      canvas.toBlob((blob) => { WGPU_SHADER_TOY.downloadBlob(filename, blob); }, type, quality);
+    }
+  },
+
+  // wgpu_shader_toy_screenshot_begin
+  wgpu_shader_toy_screenshot_begin: (width, height) => {
+    const canvas = new OffscreenCanvas(width, height);
+    // tiles are written with putImageData: keeps the canvas on the CPU
+    canvas.getContext('2d', { willReadFrequently: true });
+    WGPU_SHADER_TOY.fScreenshotCanvas = canvas;
+  },
+
+  // wgpu_shader_toy_screenshot_tile
+  wgpu_shader_toy_screenshot_tile: (x, y, width, height, data, bytesPerRow) => {
+    const canvas = WGPU_SHADER_TOY.fScreenshotCanvas;
+    if(!canvas)
+      return;
+    const context = canvas.getContext('2d');
+    const image = context.createImageData(width, height);
+    const rowSize = width * 4;
+    // rows are padded (bytesPerRow) in the mapped buffer
+    for(let row = 0; row < height; row++) {
+      const start = data + row * bytesPerRow;
+      image.data.set(HEAPU8.subarray(start, start + rowSize), row * rowSize);
+    }
+    context.putImageData(image, x, y);
+  },
+
+  // wgpu_shader_toy_export_frame
+  wgpu_shader_toy_export_frame: (filename, type, quality, width, height, data, bytesPerRow, bgra) => {
+    filename = UTF8ToString(filename);
+    type = type ? UTF8ToString(type) : 'image/png';
+    // the data is only valid during this call: it is copied before encoding (which happens asynchronously)
+    const image = new ImageData(width, height);
+    const rowSize = width * 4;
+    for(let row = 0; row < height; row++) {
+      const start = data + row * bytesPerRow;
+      image.data.set(HEAPU8.subarray(start, start + rowSize), row * rowSize);
+    }
+    if(bgra) {
+      const pixels = image.data;
+      for(let i = 0; i < pixels.length; i += 4) {
+        const b = pixels[i];
+        pixels[i] = pixels[i + 2];
+        pixels[i + 2] = b;
+      }
     }
+    const canvas = new OffscreenCanvas(width, height);
+    canvas.getContext('2d').putImageData(image, 0, 0);
+    canvas.convertToBlob({ type: type, quality: quality })
+      .then(blob => { WGPU_SHADER_TOY.downloadBlob(filename, blob); })
+      .catch(error => { console.log(`Error while saving ${filename}: ${error.message}`); });
+  },
+
+  // wgpu_shader_toy_screenshot_end
+  wgpu_shader_toy_screenshot_end: (filename, type, quality) => {
+    const canvas = WGPU_SHADER_TOY.fScreenshotCanvas;
+    WGPU_SHADER_TOY.fScreenshotCanvas = null;
+    // no filename => cancelled
+    if(!canvas || !filename)
+      return;
+    filename = UTF8ToString(filename);
+    type = type ? UTF8ToString(type) : 'image/png';
+    canvas.convertToBlob({ type: type, quality: quality })
+      .then(blob => { WGPU_SHADER_TOY.downloadBlob(filename, blob); })
+      .catch(error => { console.log(`Error while saving ${filename}: ${error.message}`); });
   },
 
 }